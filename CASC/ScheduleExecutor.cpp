@@ -8,6 +8,7 @@
 #include "Lib/Sys/Multiprocessing.hpp"
 #include "Lib/Timer.hpp"
 #include "Shell/Options.hpp"
+#include "Shell/StatisticsStream.hpp"
 
 using namespace CASC;
 using namespace Lib;
@@ -99,6 +100,7 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
     // child died, remove it from the pool and check if succeeded
     if(exited)
     {
+      Shell::StatisticsStream::sliceFinished(process, code);
       pool = Pool::remove(process, pool);
       if(!code)
       {
@@ -128,7 +130,9 @@ exit:
   {
     pid_t process = killIt.next();
     Multiprocessing::instance()->killNoCheck(process, SIGKILL);
+    Shell::StatisticsStream::sliceFinished(process, -1);
   }
+  Shell::StatisticsStream::scheduleFinished(success);
   return success;
 }
 
@@ -156,6 +160,7 @@ pid_t ScheduleExecutor::spawn(vstring code, int terminationTime)
   // parent
   if(pid)
   {
+    Shell::StatisticsStream::sliceStarted(pid, code);
     return pid;
   }
   // child
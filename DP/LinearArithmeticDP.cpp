@@ -0,0 +1,750 @@
+
+/*
+ * File LinearArithmeticDP.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LinearArithmeticDP.cpp
+ * Implements class LinearArithmeticDP.
+ */
+
+#include "Lib/Int.hpp"
+
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "LinearArithmeticDP.hpp"
+
+namespace DP
+{
+
+/** number of variables above which reset() starts with an empty tableau */
+static const unsigned MAX_VARS = 5000;
+
+const unsigned LinearArithmeticDP::NO_ROW;
+
+LinearArithmeticDP::LinearArithmeticDP()
+: _overflow(false)
+{
+  CALL("LinearArithmeticDP::LinearArithmeticDP");
+}
+
+void LinearArithmeticDP::reset()
+{
+  CALL("LinearArithmeticDP::reset");
+
+  Stack<unsigned>::Iterator bit(_bounded);
+  while(bit.hasNext()) {
+    Var& v = _vars[bit.next()];
+    v.lowerReason = 0;
+    v.upperReason = 0;
+  }
+  _bounded.reset();
+  _disequalities.reset();
+  _unsatCores.reset();
+
+  if(_overflow || _vars.size()>MAX_VARS) {
+    clearTableau();
+  }
+  _overflow = false;
+}
+
+void LinearArithmeticDP::clearTableau()
+{
+  CALL("LinearArithmeticDP::clearTableau");
+
+  _vars.reset();
+  _rows.reset();
+  _termVars.reset();
+  _sumVars.reset();
+  _bounded.reset();
+  _disequalities.reset();
+}
+
+void LinearArithmeticDP::addLiterals(LiteralIterator lits, bool onlyEqualites)
+{
+  CALL("LinearArithmeticDP::addLiterals");
+
+  while(lits.hasNext() && !_overflow) {
+    Literal* l = lits.next();
+    if(!l->ground()) {
+      continue;
+    }
+    if(onlyEqualites && !(l->isEquality() && l->isPositive())) {
+      continue;
+    }
+    try {
+      addLiteral(l);
+    }
+    catch(ArithmeticException&) {
+      //the bounds may have been updated only partially
+      _overflow = true;
+    }
+  }
+}
+
+/**
+ * If @b lit compares two arithmetic terms, assign to @b rel the relation
+ * between the first and the second argument that @b lit states and
+ * return true.
+ */
+bool LinearArithmeticDP::readRelation(Literal* lit, Relation& rel)
+{
+  CALL("LinearArithmeticDP::readRelation");
+
+  if(lit->isEquality()) {
+    rel = lit->isPositive() ? EQUAL : NOT_EQUAL;
+    return true;
+  }
+  if(!theory->isInterpretedPredicate(lit)) {
+    return false;
+  }
+  switch(theory->interpretPredicate(lit)) {
+  case Theory::INT_LESS:
+  case Theory::RAT_LESS:
+  case Theory::REAL_LESS:
+    rel = lit->isPositive() ? LESS : GREATER_EQUAL;
+    return true;
+  case Theory::INT_LESS_EQUAL:
+  case Theory::RAT_LESS_EQUAL:
+  case Theory::REAL_LESS_EQUAL:
+    rel = lit->isPositive() ? LESS_EQUAL : GREATER;
+    return true;
+  case Theory::INT_GREATER:
+  case Theory::RAT_GREATER:
+  case Theory::REAL_GREATER:
+    rel = lit->isPositive() ? GREATER : LESS_EQUAL;
+    return true;
+  case Theory::INT_GREATER_EQUAL:
+  case Theory::RAT_GREATER_EQUAL:
+  case Theory::REAL_GREATER_EQUAL:
+    rel = lit->isPositive() ? GREATER_EQUAL : LESS;
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool isArithmeticSort(unsigned sort)
+{
+  return sort==Sorts::SRT_INTEGER || sort==Sorts::SRT_RATIONAL || sort==Sorts::SRT_REAL;
+}
+
+/**
+ * If @b t is a number of sort @b sort, assign it to @b res and return true
+ */
+static bool readNumber(Term* t, unsigned sort, RationalConstantType& res)
+{
+  switch(sort) {
+  case Sorts::SRT_INTEGER: {
+    IntegerConstantType num;
+    if(!theory->tryInterpretConstant(t, num)) {
+      return false;
+    }
+    res = RationalConstantType(num);
+    return true;
+  }
+  case Sorts::SRT_RATIONAL:
+    return theory->tryInterpretConstant(t, res);
+  case Sorts::SRT_REAL: {
+    RealConstantType num;
+    if(!theory->tryInterpretConstant(t, num)) {
+      return false;
+    }
+    res = num;
+    return true;
+  }
+  default:
+    ASSERTION_VIOLATION;
+  }
+  return false;
+}
+
+/**
+ * Add @b coef times the linear form of @b t to @b sum and @b constant
+ */
+void LinearArithmeticDP::linearize(TermList t, unsigned sort, Rational coef, LinearSum& sum, Rational& constant)
+{
+  CALL("LinearArithmeticDP::linearize");
+  ASS(t.isTerm());
+
+  Term* trm = t.term();
+  Rational num;
+  if(readNumber(trm, sort, num)) {
+    constant = constant + coef*num;
+    return;
+  }
+  if(theory->isInterpretedFunction(trm)) {
+    switch(theory->interpretFunction(trm)) {
+    case Theory::INT_PLUS:
+    case Theory::RAT_PLUS:
+    case Theory::REAL_PLUS:
+      linearize(*trm->nthArgument(0), sort, coef, sum, constant);
+      linearize(*trm->nthArgument(1), sort, coef, sum, constant);
+      return;
+    case Theory::INT_MINUS:
+    case Theory::RAT_MINUS:
+    case Theory::REAL_MINUS:
+      linearize(*trm->nthArgument(0), sort, coef, sum, constant);
+      linearize(*trm->nthArgument(1), sort, -coef, sum, constant);
+      return;
+    case Theory::INT_UNARY_MINUS:
+    case Theory::RAT_UNARY_MINUS:
+    case Theory::REAL_UNARY_MINUS:
+      linearize(*trm->nthArgument(0), sort, -coef, sum, constant);
+      return;
+    case Theory::INT_MULTIPLY:
+    case Theory::RAT_MULTIPLY:
+    case Theory::REAL_MULTIPLY:
+      if(readNumber(trm->nthArgument(0)->term(), sort, num)) {
+        linearize(*trm->nthArgument(1), sort, coef*num, sum, constant);
+        return;
+      }
+      if(readNumber(trm->nthArgument(1)->term(), sort, num)) {
+        linearize(*trm->nthArgument(0), sort, coef*num, sum, constant);
+        return;
+      }
+      //non-linear multiplication is a variable
+      break;
+    default:
+      break;
+    }
+  }
+  LinearSum single;
+  single.push(Monomial(getTermVar(trm, sort), coef));
+  addMultiple(sum, single, Rational(1));
+}
+
+void LinearArithmeticDP::addLiteral(Literal* lit)
+{
+  CALL("LinearArithmeticDP::addLiteral");
+
+  Relation rel;
+  if(!readRelation(lit, rel)) {
+    return;
+  }
+  unsigned sort = lit->isEquality() ? SortHelper::getEqualityArgumentSort(lit) : SortHelper::getArgSort(lit, 0);
+  if(!isArithmeticSort(sort)) {
+    return;
+  }
+  bool isInt = sort==Sorts::SRT_INTEGER;
+
+  //the literal states sum+constant rel 0
+  static LinearSum sum;
+  sum.reset();
+  Rational constant(0);
+  linearize(*lit->nthArgument(0), sort, Rational(1), sum, constant);
+  linearize(*lit->nthArgument(1), sort, Rational(-1), sum, constant);
+
+  if(isInt && rel==LESS) {
+    constant = constant+Rational(1);
+    rel = LESS_EQUAL;
+  }
+  else if(isInt && rel==GREATER) {
+    constant = constant-Rational(1);
+    rel = GREATER_EQUAL;
+  }
+
+  if(sum.isEmpty()) {
+    bool holds;
+    switch(rel) {
+    case LESS: holds = constant<Rational(0); break;
+    case LESS_EQUAL: holds = constant<=Rational(0); break;
+    case EQUAL: holds = constant==Rational(0); break;
+    case NOT_EQUAL: holds = constant!=Rational(0); break;
+    case GREATER_EQUAL: holds = constant>=Rational(0); break;
+    case GREATER: holds = constant>Rational(0); break;
+    default: ASSERTION_VIOLATION; holds = true;
+    }
+    if(!holds) {
+      addConflict(lit, 0);
+    }
+    return;
+  }
+
+  //sort the monomials and divide them by the leading coefficient,
+  //so that equal sums get the same variable
+  for(unsigned i=1; i<sum.size(); i++) {
+    for(unsigned j=i; j>0 && sum[j-1].var>sum[j].var; j--) {
+      std::swap(sum[j-1], sum[j]);
+    }
+  }
+  Rational lead = sum[0].coef;
+  if(lead.isNegative()) {
+    switch(rel) {
+    case LESS: rel = GREATER; break;
+    case LESS_EQUAL: rel = GREATER_EQUAL; break;
+    case GREATER_EQUAL: rel = LESS_EQUAL; break;
+    case GREATER: rel = LESS; break;
+    default: break;
+    }
+  }
+  Rational bound = (-constant)/lead;
+  for(unsigned i=0; i<sum.size(); i++) {
+    sum[i].coef = sum[i].coef/lead;
+  }
+
+  //a sum of integers with integral coefficients is an integer
+  bool integral = isInt;
+  for(unsigned i=0; i<sum.size(); i++) {
+    integral &= sum[i].coef.isInt();
+  }
+  if(integral) {
+    if(!bound.isInt()) {
+      if(rel==EQUAL) {
+        addConflict(lit, 0);
+        return;
+      }
+      if(rel==NOT_EQUAL) {
+        return;
+      }
+    }
+    if(rel==LESS_EQUAL) {
+      bound = bound.floor();
+    }
+    else if(rel==GREATER_EQUAL) {
+      bound = bound.ceiling();
+    }
+  }
+  unsigned var = sum.size()==1 ? sum[0].var : getSumVar(sum, integral);
+
+  switch(rel) {
+  case LESS:
+    assertUpper(var, DeltaRational(bound, Rational(-1)), lit);
+    break;
+  case LESS_EQUAL:
+    assertUpper(var, DeltaRational(bound, Rational(0)), lit);
+    break;
+  case EQUAL:
+    assertUpper(var, DeltaRational(bound, Rational(0)), lit);
+    assertLower(var, DeltaRational(bound, Rational(0)), lit);
+    break;
+  case GREATER_EQUAL:
+    assertLower(var, DeltaRational(bound, Rational(0)), lit);
+    break;
+  case GREATER:
+    assertLower(var, DeltaRational(bound, Rational(1)), lit);
+    break;
+  case NOT_EQUAL: {
+    Disequality d;
+    d.var = var;
+    d.value = bound;
+    d.lit = lit;
+    _disequalities.push(d);
+    break;
+  }
+  }
+}
+
+unsigned LinearArithmeticDP::newVar(Term* t, bool isInt)
+{
+  CALL("LinearArithmeticDP::newVar");
+
+  Var v;
+  v.term = t;
+  v.isInt = isInt;
+  v.row = NO_ROW;
+  v.lowerReason = 0;
+  v.upperReason = 0;
+  _vars.push(v);
+  return _vars.size()-1;
+}
+
+unsigned LinearArithmeticDP::getTermVar(Term* t, unsigned sort)
+{
+  CALL("LinearArithmeticDP::getTermVar");
+
+  unsigned* pvar;
+  if(_termVars.getValuePtr(t, pvar)) {
+    *pvar = newVar(t, sort==Sorts::SRT_INTEGER);
+  }
+  return *pvar;
+}
+
+/**
+ * Return the variable equal to @b sum, adding a row defining it
+ * if there is none
+ */
+unsigned LinearArithmeticDP::getSumVar(LinearSum& sum, bool isInt)
+{
+  CALL("LinearArithmeticDP::getSumVar");
+
+  vstring key;
+  for(unsigned i=0; i<sum.size(); i++) {
+    key += Int::toString(sum[i].var)+"*"+sum[i].coef.toString()+" ";
+  }
+  unsigned* pvar;
+  if(!_sumVars.getValuePtr(key, pvar)) {
+    return *pvar;
+  }
+
+  //express the sum by the non-basic variables
+  Row row;
+  DeltaRational value;
+  for(unsigned i=0; i<sum.size(); i++) {
+    Var& v = _vars[sum[i].var];
+    if(v.row==NO_ROW) {
+      LinearSum single;
+      single.push(sum[i]);
+      addMultiple(row.sum, single, Rational(1));
+    }
+    else {
+      addMultiple(row.sum, _rows[v.row].sum, sum[i].coef);
+    }
+    value = value+v.value*sum[i].coef;
+  }
+  unsigned var = newVar(0, isInt);
+  _vars[var].value = value;
+  _vars[var].row = _rows.size();
+  row.basic = var;
+  _rows.push(row);
+  *pvar = var;
+  return var;
+}
+
+void LinearArithmeticDP::addConflict(Literal* l1, Literal* l2)
+{
+  CALL("LinearArithmeticDP::addConflict");
+
+  _unsatCores.push(LiteralStack());
+  _unsatCores.top().push(l1);
+  if(l2 && l2!=l1) {
+    _unsatCores.top().push(l2);
+  }
+}
+
+void LinearArithmeticDP::assertUpper(unsigned var, DeltaRational bound, Literal* reason)
+{
+  CALL("LinearArithmeticDP::assertUpper");
+
+  Var& v = _vars[var];
+  if(v.upperReason && v.upper<=bound) {
+    return;
+  }
+  if(v.lowerReason && bound<v.lower) {
+    addConflict(v.lowerReason, reason);
+    return;
+  }
+  if(!v.lowerReason && !v.upperReason) {
+    _bounded.push(var);
+  }
+  v.upper = bound;
+  v.upperReason = reason;
+  if(v.row==NO_ROW && v.value>bound) {
+    update(var, bound);
+  }
+}
+
+void LinearArithmeticDP::assertLower(unsigned var, DeltaRational bound, Literal* reason)
+{
+  CALL("LinearArithmeticDP::assertLower");
+
+  Var& v = _vars[var];
+  if(v.lowerReason && v.lower>=bound) {
+    return;
+  }
+  if(v.upperReason && bound>v.upper) {
+    addConflict(v.upperReason, reason);
+    return;
+  }
+  if(!v.lowerReason && !v.upperReason) {
+    _bounded.push(var);
+  }
+  v.lower = bound;
+  v.lowerReason = reason;
+  if(v.row==NO_ROW && v.value<bound) {
+    update(var, bound);
+  }
+}
+
+/**
+ * Assign @b value to the non-basic variable @b var and update the basic ones
+ */
+void LinearArithmeticDP::update(unsigned var, DeltaRational value)
+{
+  CALL("LinearArithmeticDP::update");
+  ASS_EQ(_vars[var].row, NO_ROW);
+
+  DeltaRational diff = value-_vars[var].value;
+  Stack<Row>::Iterator rit(_rows);
+  while(rit.hasNext()) {
+    Row& row = rit.next();
+    Rational coef = coefficient(row.sum, var);
+    if(!coef.isZero()) {
+      Var& b = _vars[row.basic];
+      b.value = b.value+diff*coef;
+    }
+  }
+  _vars[var].value = value;
+}
+
+void LinearArithmeticDP::pivotAndUpdate(unsigned basic, unsigned nonBasic, DeltaRational value)
+{
+  CALL("LinearArithmeticDP::pivotAndUpdate");
+
+  unsigned rowIdx = _vars[basic].row;
+  Rational coef = coefficient(_rows[rowIdx].sum, nonBasic);
+  DeltaRational theta = (value-_vars[basic].value)/coef;
+  _vars[basic].value = value;
+  _vars[nonBasic].value = _vars[nonBasic].value+theta;
+  for(unsigned i=0; i<_rows.size(); i++) {
+    if(i==rowIdx) {
+      continue;
+    }
+    Rational c = coefficient(_rows[i].sum, nonBasic);
+    if(!c.isZero()) {
+      Var& b = _vars[_rows[i].basic];
+      b.value = b.value+theta*c;
+    }
+  }
+  pivot(basic, nonBasic);
+}
+
+/**
+ * Make @b nonBasic the basic variable of the row of @b basic
+ */
+void LinearArithmeticDP::pivot(unsigned basic, unsigned nonBasic)
+{
+  CALL("LinearArithmeticDP::pivot");
+
+  unsigned rowIdx = _vars[basic].row;
+  LinearSum& sum = _rows[rowIdx].sum;
+  Rational coef = coefficient(sum, nonBasic);
+  ASS(!coef.isZero());
+
+  //nonBasic = basic/coef - sum of the others/coef
+  LinearSum solved;
+  solved.push(Monomial(basic, Rational(1)/coef));
+  for(unsigned i=0; i<sum.size(); i++) {
+    if(sum[i].var!=nonBasic) {
+      solved.push(Monomial(sum[i].var, -sum[i].coef/coef));
+    }
+  }
+  sum = solved;
+  _rows[rowIdx].basic = nonBasic;
+  _vars[nonBasic].row = rowIdx;
+  _vars[basic].row = NO_ROW;
+
+  for(unsigned i=0; i<_rows.size(); i++) {
+    if(i==rowIdx) {
+      continue;
+    }
+    LinearSum& other = _rows[i].sum;
+    for(unsigned j=0; j<other.size(); j++) {
+      if(other[j].var==nonBasic) {
+        Rational c = other[j].coef;
+        std::swap(other[j], other.top());
+        other.pop();
+        addMultiple(other, solved, c);
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * Repair the basic variables violating their bounds and return false
+ * if that is impossible, adding the explanation to the unsat cores
+ */
+bool LinearArithmeticDP::check()
+{
+  CALL("LinearArithmeticDP::check");
+
+  //Bland's rule, the smallest variables are chosen
+  while(true) {
+    unsigned basic = NO_ROW;
+    bool belowLower = false;
+    for(unsigned i=0; i<_vars.size(); i++) {
+      Var& v = _vars[i];
+      if(v.row==NO_ROW) {
+        continue;
+      }
+      if(v.lowerReason && v.value<v.lower) {
+        basic = i;
+        belowLower = true;
+        break;
+      }
+      if(v.upperReason && v.value>v.upper) {
+        basic = i;
+        break;
+      }
+    }
+    if(basic==NO_ROW) {
+      return true;
+    }
+
+    //to increase a basic variable below its lower bound, a non-basic one with a positive
+    //coefficient has to be increased or one with a negative coefficient decreased
+    LinearSum& sum = _rows[_vars[basic].row].sum;
+    unsigned nonBasic = NO_ROW;
+    for(unsigned i=0; i<sum.size(); i++) {
+      Var& v = _vars[sum[i].var];
+      bool increase = sum[i].coef.isNegative() ? !belowLower : belowLower;
+      bool canMove = increase ? (!v.upperReason || v.value<v.upper) : (!v.lowerReason || v.value>v.lower);
+      if(canMove && sum[i].var<nonBasic) {
+        nonBasic = sum[i].var;
+      }
+    }
+    if(nonBasic!=NO_ROW) {
+      pivotAndUpdate(basic, nonBasic, belowLower ? _vars[basic].lower : _vars[basic].upper);
+      continue;
+    }
+
+    //the bounds of the row contradict the violated bound
+    _unsatCores.push(LiteralStack());
+    LiteralStack& core = _unsatCores.top();
+    core.push(belowLower ? _vars[basic].lowerReason : _vars[basic].upperReason);
+    for(unsigned i=0; i<sum.size(); i++) {
+      Var& v = _vars[sum[i].var];
+      bool increase = sum[i].coef.isNegative() ? !belowLower : belowLower;
+      Literal* reason = increase ? v.upperReason : v.lowerReason;
+      ASS(reason);
+      if(!core.find(reason)) {
+        core.push(reason);
+      }
+    }
+    return false;
+  }
+}
+
+/**
+ * Return true if the assignment is integral where it should be and
+ * satisfies the disequalities
+ */
+bool LinearArithmeticDP::modelIsExact()
+{
+  CALL("LinearArithmeticDP::modelIsExact");
+
+  Stack<Disequality>::Iterator dit(_disequalities);
+  while(dit.hasNext()) {
+    Disequality& d = dit.next();
+    if(_vars[d.var].value==DeltaRational(d.value, Rational(0))) {
+      return false;
+    }
+  }
+  for(unsigned i=0; i<_vars.size(); i++) {
+    Var& v = _vars[i];
+    if(v.isInt && (!v.value.c.isInt() || !v.value.k.isZero())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Round down the non-integral values of the non-basic integer variables
+ * and integral sums.
+ * Their bounds are integral, so they are still satisfied afterwards.
+ */
+void LinearArithmeticDP::roundIntegers()
+{
+  CALL("LinearArithmeticDP::roundIntegers");
+
+  for(unsigned i=0; i<_vars.size(); i++) {
+    Var& v = _vars[i];
+    if(!v.isInt || v.row!=NO_ROW || (v.value.c.isInt() && v.value.k.isZero())) {
+      continue;
+    }
+    Rational c = v.value.c;
+    update(i, DeltaRational(c.isInt() ? c : c.floor(), Rational(0)));
+  }
+}
+
+DecisionProcedure::Status LinearArithmeticDP::getStatus(bool retrieveMultipleCores)
+{
+  CALL("LinearArithmeticDP::getStatus");
+
+  if(_overflow) {
+    _unsatCores.reset();
+    return UNKNOWN;
+  }
+  if(_unsatCores.isEmpty()) {
+    try {
+      check();
+    }
+    catch(ArithmeticException&) {
+      _overflow = true;
+      _unsatCores.reset();
+      return UNKNOWN;
+    }
+  }
+  if(_unsatCores.isNonEmpty()) {
+    if(!retrieveMultipleCores) {
+      _unsatCores.truncate(1);
+    }
+    return UNSATISFIABLE;
+  }
+  if(modelIsExact()) {
+    return SATISFIABLE;
+  }
+  try {
+    roundIntegers();
+    //the bounds were satisfiable before the rounding
+    ALWAYS(check());
+  }
+  catch(ArithmeticException&) {
+    _overflow = true;
+    return UNKNOWN;
+  }
+  return modelIsExact() ? SATISFIABLE : UNKNOWN;
+}
+
+void LinearArithmeticDP::getUnsatCore(LiteralStack& res, unsigned coreIndex)
+{
+  CALL("LinearArithmeticDP::getUnsatCore");
+  ASS(res.isEmpty());
+  ASS_L(coreIndex, _unsatCores.size());
+
+  res = _unsatCores[coreIndex];
+}
+
+LinearArithmeticDP::Rational LinearArithmeticDP::coefficient(const LinearSum& sum, unsigned var)
+{
+  for(unsigned i=0; i<sum.size(); i++) {
+    if(sum[i].var==var) {
+      return sum[i].coef;
+    }
+  }
+  return Rational(0);
+}
+
+/**
+ * Add @b coef times @b added to @b sum
+ */
+void LinearArithmeticDP::addMultiple(LinearSum& sum, const LinearSum& added, Rational coef)
+{
+  for(unsigned i=0; i<added.size(); i++) {
+    unsigned var = added[i].var;
+    Rational c = added[i].coef*coef;
+    bool found = false;
+    for(unsigned j=0; j<sum.size(); j++) {
+      if(sum[j].var==var) {
+        sum[j].coef = sum[j].coef+c;
+        if(sum[j].coef.isZero()) {
+          std::swap(sum[j], sum.top());
+          sum.pop();
+        }
+        found = true;
+        break;
+      }
+    }
+    if(!found && !c.isZero()) {
+      sum.push(Monomial(var, c));
+    }
+  }
+}
+
+}
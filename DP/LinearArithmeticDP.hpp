@@ -0,0 +1,192 @@
+
+/*
+ * File LinearArithmeticDP.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file LinearArithmeticDP.hpp
+ * Defines class LinearArithmeticDP.
+ */
+
+#ifndef __LinearArithmeticDP__
+#define __LinearArithmeticDP__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Term.hpp"
+#include "Kernel/Theory.hpp"
+
+#include "DecisionProcedure.hpp"
+
+namespace DP {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Decision procedure for ground linear arithmetic over the integers,
+ * rationals and reals, by the simplex method of Dutertre and de Moura,
+ * "A Fast Linear-Arithmetic Solver for DPLL(T)" (CAV 2006).
+ *
+ * Each linear combination of terms compared in a literal gets a variable
+ * defined by a row of the tableau, and the literals become bounds on the
+ * variables. reset() retracts the bounds but keeps the tableau and the
+ * assignment, so that the next check starts from the last solution.
+ * Strict bounds are represented by rationals with an infinitesimal part.
+ *
+ * Terms other than sums, differences, negations and multiplications by
+ * a number are treated as variables. Integer problems are solved over the
+ * rationals, so if the solution is not integral even after rounding the
+ * non-basic integer variables, or does not satisfy the disequalities,
+ * the status is UNKNOWN.
+ */
+class LinearArithmeticDP : public DecisionProcedure
+{
+public:
+  CLASS_NAME(LinearArithmeticDP);
+  USE_ALLOCATOR(LinearArithmeticDP);
+
+  LinearArithmeticDP();
+
+  virtual void addLiterals(LiteralIterator lits, bool onlyEqualites) override;
+
+  virtual Status getStatus(bool retrieveMultipleCores) override;
+  virtual unsigned getUnsatCoreCount() override { return _unsatCores.size(); }
+  virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex) override;
+
+  /** The model is not expressed by literals, so none are added */
+  void getModel(LiteralStack& model) override {}
+
+  virtual void reset() override;
+
+private:
+  typedef RationalConstantType Rational;
+
+  /** A rational number plus a multiple of an infinitesimal */
+  struct DeltaRational
+  {
+    DeltaRational() : c(0), k(0) {}
+    DeltaRational(Rational c, Rational k) : c(c), k(k) {}
+
+    DeltaRational operator+(const DeltaRational& o) const { return DeltaRational(c+o.c, k+o.k); }
+    DeltaRational operator-(const DeltaRational& o) const { return DeltaRational(c-o.c, k-o.k); }
+    DeltaRational operator*(const Rational& r) const { return DeltaRational(c*r, k*r); }
+    DeltaRational operator/(const Rational& r) const { return DeltaRational(c/r, k/r); }
+
+    bool operator==(const DeltaRational& o) const { return c==o.c && k==o.k; }
+    bool operator<(const DeltaRational& o) const { return c<o.c || (c==o.c && k<o.k); }
+    bool operator>(const DeltaRational& o) const { return o<*this; }
+    bool operator<=(const DeltaRational& o) const { return !(o<*this); }
+    bool operator>=(const DeltaRational& o) const { return !(*this<o); }
+
+    Rational c;
+    Rational k;
+  };
+
+  struct Monomial
+  {
+    Monomial() {}
+    Monomial(unsigned var, Rational coef) : var(var), coef(coef) {}
+
+    unsigned var;
+    Rational coef;
+  };
+  typedef Stack<Monomial> LinearSum;
+
+  /** Defines a basic variable by a sum of non-basic ones */
+  struct Row
+  {
+    unsigned basic;
+    LinearSum sum;
+  };
+
+  struct Var
+  {
+    /** the term of a variable for a term, zero for a linear sum */
+    Term* term;
+    /** the variable takes only integer values */
+    bool isInt;
+    DeltaRational value;
+    /** the row defining the variable, or NO_ROW if it is not basic */
+    unsigned row;
+    /** the literals bounding the variable, zero if it has no bound */
+    Literal* lowerReason;
+    Literal* upperReason;
+    DeltaRational lower;
+    DeltaRational upper;
+  };
+
+  /** The value of a variable that a negative equality excludes */
+  struct Disequality
+  {
+    unsigned var;
+    Rational value;
+    Literal* lit;
+  };
+
+  enum Relation {
+    LESS,
+    LESS_EQUAL,
+    EQUAL,
+    NOT_EQUAL,
+    GREATER_EQUAL,
+    GREATER
+  };
+
+  static const unsigned NO_ROW = 0xFFFFFFFF;
+
+  void addLiteral(Literal* lit);
+  bool readRelation(Literal* lit, Relation& rel);
+  void linearize(TermList t, unsigned sort, Rational coef, LinearSum& sum, Rational& constant);
+  unsigned getTermVar(Term* t, unsigned sort);
+  unsigned getSumVar(LinearSum& sum, bool isInt);
+  unsigned newVar(Term* t, bool isInt);
+
+  void assertUpper(unsigned var, DeltaRational bound, Literal* reason);
+  void assertLower(unsigned var, DeltaRational bound, Literal* reason);
+  void update(unsigned var, DeltaRational value);
+  void pivotAndUpdate(unsigned basic, unsigned nonBasic, DeltaRational value);
+  void pivot(unsigned basic, unsigned nonBasic);
+  bool check();
+  void addConflict(Literal* l1, Literal* l2);
+  bool modelIsExact();
+  void roundIntegers();
+  void clearTableau();
+
+  static Rational coefficient(const LinearSum& sum, unsigned var);
+  static void addMultiple(LinearSum& sum, const LinearSum& added, Rational coef);
+
+  Stack<Var> _vars;
+  Stack<Row> _rows;
+  DHMap<Term*,unsigned> _termVars;
+  /** variables of the linear sums, by the sums printed with normalized coefficients */
+  DHMap<vstring,unsigned> _sumVars;
+
+  /** variables with bounds, to be cleared by reset() */
+  Stack<unsigned> _bounded;
+  Stack<Disequality> _disequalities;
+  Stack<LiteralStack> _unsatCores;
+  /** an arithmetic operation overflowed, so the tableau cannot be trusted */
+  bool _overflow;
+};
+
+}
+
+#endif // __LinearArithmeticDP__
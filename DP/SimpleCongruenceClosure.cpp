@@ -27,11 +27,13 @@
 
 #include "Lib/ArrayMap.hpp"
 
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
-#include "Lib/IntUnionFind.hpp"
 #include "Lib/SafeRecursion.hpp"
 #include "Lib/DynamicHeap.hpp"
 
+#include "Debug/RuntimeStatistics.hpp"
+
 #include "Kernel/Signature.hpp"
 #include "Kernel/SortHelper.hpp"
 
@@ -151,8 +153,8 @@ void SimpleCongruenceClosure::ConstInfo::assertValid(SimpleCongruenceClosure& pa
 #endif
 
 
-SimpleCongruenceClosure::SimpleCongruenceClosure(Ordering* ord) :
-  _ord(ord)
+SimpleCongruenceClosure::SimpleCongruenceClosure(Ordering* ord, bool incremental) :
+  _ord(ord), _incremental(incremental)
 {
   CALL("SimpleCongruenceClosure::SimpleCongruenceClosure");
 
@@ -169,6 +171,13 @@ void SimpleCongruenceClosure::reset()
 {
   CALL("SimpleCongruenceClosure::reset");
 
+  if(_incremental) {
+    //the literals not added again are retracted by getStatus
+    _added.reset();
+    _unsatEqs.reset();
+    return;
+  }
+
 #if 0
   _cInfos.expand(1);
   _sigConsts.reset();
@@ -444,7 +453,7 @@ SimpleCongruenceClosure::CEq SimpleCongruenceClosure::convertFOEquality(Literal*
 void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualites)
 {
   CALL("SimpleCongruenceClosure::addLiterals");
-  ASS(!_hadPropagated);
+  ASS(_incremental || !_hadPropagated);
 
   while(lits.hasNext()) {
     Literal* l = lits.next();
@@ -455,7 +464,12 @@ void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualit
     }
 
     if (!onlyEqualites || (l->isEquality() && l->isPositive())) {
-      addLiteral(l);
+      if(_incremental) {
+        _added.push(l);
+      }
+      else {
+        addLiteral(l);
+      }
     }
   }
 }
@@ -523,6 +537,179 @@ void SimpleCongruenceClosure::makeProofRepresentant(unsigned c)
   ASS(transfPrem.isInvalid()); //the proof tree root has invalid equality as a premise
 }
 
+/**
+ * Undo the merge @b m, which must be the last one not undone yet
+ */
+void SimpleCongruenceClosure::undoMerge(const Merge& m)
+{
+  CALL("SimpleCongruenceClosure::undoMerge");
+
+  while(_pairTrail.size()>m.pairTrailSize) {
+    ALWAYS(_pairNames.remove(_pairTrail.pop()));
+  }
+
+  ConstInfo& aInfo = _cInfos[m.aRep];
+  ConstInfo& bInfo = _cInfos[m.bRep];
+  ASS_EQ(aInfo.reprConst, m.bRep);
+  aInfo.reprConst = 0;
+  Stack<unsigned>::Iterator aChildIt(aInfo.classList);
+  while(aChildIt.hasNext()) {
+    _cInfos[aChildIt.next()].reprConst = m.aRep;
+  }
+  bInfo.classList.truncate(m.bClassSize);
+  bInfo.useList.truncate(m.bUseSize);
+
+  //the edge may have been reversed by later merges
+  ConstInfo& aProofInfo = _cInfos[m.aProof];
+  ConstInfo& bProofInfo = _cInfos[m.bProof];
+  if(aProofInfo.proofPredecessor==m.bProof) {
+    aProofInfo.proofPredecessor = 0;
+    aProofInfo.predecessorPremise = CEq(0,0);
+  }
+  else {
+    ASS_EQ(bProofInfo.proofPredecessor, m.aProof);
+    bProofInfo.proofPredecessor = 0;
+    bProofInfo.predecessorPremise = CEq(0,0);
+  }
+}
+
+void SimpleCongruenceClosure::push()
+{
+  CALL("SimpleCongruenceClosure::push");
+
+  propagate();
+
+  Level lvl;
+  lvl.mergeCnt = _merges.size();
+  lvl.negEqCnt = _negEqualities.size();
+  lvl.distinctCnt = _distinctConstraints.size();
+  lvl.negDistinctCnt = _negDistinctConstraints.size();
+  _levels.push(lvl);
+}
+
+/**
+ * Retract the literals added since the matching call to push()
+ */
+void SimpleCongruenceClosure::pop()
+{
+  CALL("SimpleCongruenceClosure::pop");
+
+  Level lvl = _levels.pop();
+  _pendingEqualities.reset();
+  while(_merges.size()>lvl.mergeCnt) {
+    undoMerge(_merges.pop());
+  }
+  _negEqualities.truncate(lvl.negEqCnt);
+  _distinctConstraints.truncate(lvl.distinctCnt);
+  _negDistinctConstraints.truncate(lvl.negDistinctCnt);
+  _unsatEqs.reset();
+}
+
+/**
+ * True if the terms of @b lit already have their constants
+ */
+bool SimpleCongruenceClosure::isConverted(Literal* lit)
+{
+  CALL("SimpleCongruenceClosure::isConverted");
+
+  if(lit->isEquality() || isDistinctPred(lit)) {
+    Literal::Iterator ait(lit);
+    while(ait.hasNext()) {
+      if(!_termNames.find(ait.next())) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return _litNames.find(lit) || _litNames.find(Literal::complementaryLiteral(lit));
+}
+
+void SimpleCongruenceClosure::convertLiteral(Literal* lit)
+{
+  CALL("SimpleCongruenceClosure::convertLiteral");
+
+  if(lit->isEquality() || isDistinctPred(lit)) {
+    Literal::Iterator ait(lit);
+    while(ait.hasNext()) {
+      convertFO(ait.next());
+    }
+  }
+  else {
+    convertFONonEquality(lit);
+  }
+}
+
+/**
+ * In the incremental mode, make the asserted literals equal to those added
+ * since the last reset. The longest prefix of the asserted literals that
+ * were all added again is kept, the other levels are popped and the
+ * remaining added literals are asserted, each on a new level.
+ *
+ * The popped literals that were added again are asserted first, so that
+ * the literals that keep changing move to the top of the stack.
+ */
+void SimpleCongruenceClosure::updateAssertedLiterals()
+{
+  CALL("SimpleCongruenceClosure::updateAssertedLiterals");
+  ASS(_incremental);
+  ASS_EQ(_asserted.size(), _levels.size());
+
+  static DHSet<Literal*> lits;
+  lits.reset();
+  lits.loadFromIterator(LiteralStack::ConstIterator(_added));
+
+  unsigned keep = 0;
+  while(keep<_asserted.size() && lits.contains(_asserted[keep])) {
+    keep++;
+  }
+  //new terms can get their constants only when no classes are merged
+  bool convert = false;
+  LiteralStack::ConstIterator ait(_added);
+  while(ait.hasNext()) {
+    if(!isConverted(ait.next())) {
+      convert = true;
+      keep = 0;
+      break;
+    }
+  }
+
+  static LiteralStack toAssert;
+  toAssert.reset();
+  for(unsigned i=keep; i<_asserted.size(); i++) {
+    if(lits.contains(_asserted[i])) {
+      toAssert.push(_asserted[i]);
+    }
+  }
+
+  RSTAT_CTR_INC_MANY("cc_retracted_literals",_asserted.size()-keep);
+  while(_asserted.size()>keep) {
+    pop();
+    _asserted.pop();
+  }
+  if(convert) {
+    ASS(_merges.isEmpty());
+    LiteralStack::BottomFirstIterator cit(_added);
+    while(cit.hasNext()) {
+      convertLiteral(cit.next());
+    }
+  }
+
+  lits.reset();
+  lits.loadFromIterator(LiteralStack::ConstIterator(_asserted));
+  toAssert.loadFromIterator(LiteralStack::BottomFirstIterator(_added));
+  LiteralStack::BottomFirstIterator nit(toAssert);
+  while(nit.hasNext()) {
+    Literal* lit = nit.next();
+    if(!lits.insert(lit)) {
+      continue;
+    }
+    push();
+    addLiteral(lit);
+    _asserted.push(lit);
+    RSTAT_CTR_INC("cc_asserted_literals");
+  }
+}
+
 /**
  * Propagate any pending equalities
  *
@@ -569,6 +756,18 @@ void SimpleCongruenceClosure::propagate()
     DEBUG_CODE( aInfo.assertValid(*this, aRep); );
     DEBUG_CODE( bInfo.assertValid(*this, bRep); );
 
+    if(_levels.isNonEmpty()) {
+      Merge m;
+      m.aRep = aRep;
+      m.bRep = bRep;
+      m.aProof = curr0.c1;
+      m.bProof = curr0.c2;
+      m.bClassSize = bInfo.classList.size();
+      m.bUseSize = bInfo.useList.size();
+      m.pairTrailSize = _pairTrail.size();
+      _merges.push(m);
+    }
+
     // Merge first class into second (which is why we wanted the first to be smaller)
     // To do this we update the representative for all constants in
     // the class of aRep to be bRep
@@ -597,6 +796,9 @@ void SimpleCongruenceClosure::propagate()
       else {
 	*pDerefPairName = usePairConst;
 	bInfo.useList.push(usePairConst);
+	if(_levels.isNonEmpty()) {
+	  _pairTrail.push(derefPair);
+	}
       }
     }
   }
@@ -680,6 +882,11 @@ DecisionProcedure::Status SimpleCongruenceClosure::getStatus(bool retrieveMultip
 {
   CALL("SimpleCongruenceClosure::getStatus");
 
+  _unsatEqs.reset();
+  if(_incremental) {
+    updateAssertedLiterals();
+  }
+
   // Propagate any pending equalities
   propagate();
 
@@ -815,14 +1022,14 @@ void SimpleCongruenceClosure::getUnsatCore(LiteralStack& res, unsigned coreIndex
   toExplain.push(CPair(unsatEq.c1, unsatEq.c2));
   ASS_EQ(deref(toExplain.top().first), deref(toExplain.top().second));
 
-  IntUnionFind explained(getMaxConst()+1);
+  _explainedParent.expand(getMaxConst()+1, 0);
   static Stack<unsigned> pathStack;
 
   while(toExplain.isNonEmpty()) {
     CPair curr = toExplain.pop();
     ASS_EQ(deref(curr.first), deref(curr.second));
 
-    if(explained.root(curr.first)==explained.root(curr.second)) {
+    if(explainedRoot(curr.first)==explainedRoot(curr.second)) {
       //we've already explained this equality
       continue;
     }
@@ -832,7 +1039,7 @@ void SimpleCongruenceClosure::getUnsatCore(LiteralStack& res, unsigned coreIndex
     while(pathStack.isNonEmpty()) {
       unsigned proofStepConst = pathStack.pop();
       CEq& prem = _cInfos[proofStepConst].predecessorPremise;
-      if(explained.root(prem.c1)==explained.root(prem.c2)) {
+      if(explainedRoot(prem.c1)==explainedRoot(prem.c2)) {
         //we've already explained this equality
         continue;
       }
@@ -854,8 +1061,46 @@ void SimpleCongruenceClosure::getUnsatCore(LiteralStack& res, unsigned coreIndex
 	toExplain.push(CPair(cp1.second, cp2.second));
 	ASS_EQ(deref(toExplain.top().first), deref(toExplain.top().second));
       }
-      explained.doUnion(prem.c1, prem.c2);
+      explainedUnion(prem.c1, prem.c2);
+    }
+  }
+  resetExplained();
+}
+
+unsigned SimpleCongruenceClosure::explainedRoot(unsigned c)
+{
+  CALL("SimpleCongruenceClosure::explainedRoot");
+
+  while(_explainedParent[c]) {
+    unsigned parent = _explainedParent[c];
+    if(_explainedParent[parent]) {
+      //path halving
+      _explainedParent[c] = _explainedParent[parent];
     }
+    c = parent;
+  }
+  return c;
+}
+
+void SimpleCongruenceClosure::explainedUnion(unsigned c1, unsigned c2)
+{
+  CALL("SimpleCongruenceClosure::explainedUnion");
+
+  unsigned r1 = explainedRoot(c1);
+  unsigned r2 = explainedRoot(c2);
+  if(r1==r2) {
+    return;
+  }
+  _explainedParent[r1] = r2;
+  _explainedTouched.push(r1);
+}
+
+void SimpleCongruenceClosure::resetExplained()
+{
+  CALL("SimpleCongruenceClosure::resetExplained");
+
+  while(_explainedTouched.isNonEmpty()) {
+    _explainedParent[_explainedTouched.pop()] = 0;
   }
 }
 
@@ -60,7 +60,7 @@ public:
   CLASS_NAME(SimpleCongruenceClosure);
   USE_ALLOCATOR(SimpleCongruenceClosure);
 
-  SimpleCongruenceClosure(Ordering* ord);
+  SimpleCongruenceClosure(Ordering* ord, bool incremental = false);
 
   virtual void addLiterals(LiteralIterator lits, bool onlyEqualites) override;
 
@@ -88,6 +88,14 @@ public:
     return deref(_termNames.get(t));
   }
 
+  /**
+   * Start a new backtracking level. The literals added after the call
+   * are retracted by the matching pop().
+   */
+  void push();
+  void pop();
+  unsigned level() const { return _levels.size(); }
+
 private:
   Ordering* _ord;
   
@@ -170,6 +178,10 @@ private:
   bool checkPositiveDistincts(bool retrieveMultipleCores);
   Status checkNegativeDistincts(bool retrieveMultipleCores);
 
+  bool isConverted(Literal* lit);
+  void convertLiteral(Literal* lit);
+  void updateAssertedLiterals();
+
   void addPendingEquality(CEq eq);
   void makeProofRepresentant(unsigned c);
   void propagate();
@@ -177,6 +189,10 @@ private:
   unsigned getProofDepth(unsigned c);
   void collectUnifyingPath(unsigned c1, unsigned c2, Stack<unsigned>& path);
 
+  unsigned explainedRoot(unsigned c);
+  void explainedUnion(unsigned c1, unsigned c2);
+  void resetExplained();
+
   static const unsigned NO_SIG_SYMBOL;
   struct ConstInfo
   {
@@ -313,6 +329,56 @@ private:
    * this would cause problems with term caches upon reset.
    */
   bool _hadPropagated;
+
+  /**
+   * In the incremental mode, reset() does not retract the literals. Instead,
+   * getStatus() pops the levels of those that were not added since the reset,
+   * and pushes a level for each new one.
+   */
+  bool _incremental;
+
+  /** What is needed to undo the merge of the class of aRep into the class of bRep */
+  struct Merge
+  {
+    unsigned aRep;
+    unsigned bRep;
+    /** the constants connected by the edge added to the proof forest */
+    unsigned aProof;
+    unsigned bProof;
+    unsigned bClassSize;
+    unsigned bUseSize;
+    /** the size of _pairTrail before the merge */
+    unsigned pairTrailSize;
+  };
+  void undoMerge(const Merge& m);
+
+  struct Level
+  {
+    unsigned mergeCnt;
+    unsigned negEqCnt;
+    unsigned distinctCnt;
+    unsigned negDistinctCnt;
+  };
+
+  /** merges done since the first level was pushed */
+  Stack<Merge> _merges;
+  /** pairs added to _pairNames by the merges */
+  Stack<CPair> _pairTrail;
+  Stack<Level> _levels;
+
+  /** in the incremental mode, the literal asserted on each level */
+  LiteralStack _asserted;
+  /** in the incremental mode, the literals added since the last reset */
+  LiteralStack _added;
+
+  /**
+   * Union-find over the constants recording the equalities explained so far
+   * by getUnsatCore(), zero stands for a root. Only the touched entries are
+   * reset after each core, so that a core costs time proportional to its
+   * explanation rather than to the number of constants.
+   */
+  DArray<unsigned> _explainedParent;
+  Stack<unsigned> _explainedTouched;
 }; // class SimpleCongruenceClosure
 
 }
@@ -192,6 +192,7 @@ class Clause;
 typedef VirtualIterator<Clause*> ClauseIterator;
 typedef SingleParamEvent<Clause*> ClauseEvent;
 typedef List<Clause*> ClauseList;
+class CompressedClause;
 typedef Stack<Clause*> ClauseStack;
 
 typedef VirtualIterator<Literal*> LiteralIterator;
@@ -317,10 +318,12 @@ class UnprocessedClauseContainer;
 
 class PassiveClauseContainer;
 typedef Lib::SmartPtr<PassiveClauseContainer> PassiveClauseContainerSP;
+class CompressedPassiveClauseContainer;
 
 class ActiveClauseContainer;
 
 class Limits;
+class Checkpoint;
 class Splitter;
 class ConsequenceFinder;
 class LabelFinder;
@@ -334,6 +337,8 @@ class InferenceEngine;
 class GeneratingInferenceEngine;
 typedef Lib::SmartPtr<GeneratingInferenceEngine> GeneratingInferenceEngineSP;
 
+class ClauseRecipe;
+
 class ImmediateSimplificationEngine;
 typedef Lib::SmartPtr<ImmediateSimplificationEngine> ImmediateSimplificationEngineSP;
 
@@ -23,10 +23,12 @@
  */
 
 #include "Lib/Allocator.hpp"
+#include "Lib/Metaiterators.hpp"
 #include "Lib/Recycler.hpp"
 #include "Lib/TimeCounter.hpp"
 #include "Lib/VirtualIterator.hpp"
 
+#include "Kernel/Clause.hpp"
 #include "Kernel/Renaming.hpp"
 #include "Kernel/SubstHelper.hpp"
 #include "Kernel/Term.hpp"
@@ -471,7 +473,11 @@ ClauseSResResultIterator CodeTreeSubsumptionIndex
     return ClauseSResResultIterator::getEmpty();
   }
 
-  return vi( new ClauseSResIterator(&_ct, cl, subsumptionResolution) );
+  ClauseSResResultIterator res = vi( new ClauseSResIterator(&_ct, cl, subsumptionResolution) );
+  if(_skipDormant) {
+    res = pvi( getFilteredIterator(res, ClauseSResQueryResult::NonDormantFn()) );
+  }
+  return res;
 }
 
 
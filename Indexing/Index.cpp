@@ -22,6 +22,8 @@
  *
  */
 
+#include "Kernel/Clause.hpp"
+
 #include "Index.hpp"
 
 
@@ -54,4 +56,19 @@ void Index::attachContainer(ClauseContainer* cc)
   _removedSD = cc->removedEvent.subscribe(this,&Index::onRemovedFromContainer);
 }
 
+bool SLQueryResult::NonDormantFn::operator()(const SLQueryResult& res)
+{
+  return !res.clause->isDormant();
+}
+
+bool TermQueryResult::NonDormantFn::operator()(const TermQueryResult& res)
+{
+  return !res.clause->isDormant();
+}
+
+bool ClauseSResQueryResult::NonDormantFn::operator()(const ClauseSResQueryResult& res)
+{
+  return !res.clause->isDormant();
+}
+
 }
@@ -71,6 +71,12 @@ struct SLQueryResult
       return res.clause;
     }
   };
+
+  struct NonDormantFn
+  {
+    DECL_RETURN_TYPE(bool);
+    bool operator()(const SLQueryResult& res);
+  };
 };
 
 /**
@@ -91,6 +97,12 @@ struct TermQueryResult
   Clause* clause;
   ResultSubstitutionSP substitution;
   UnificationConstraintStackSP constraints;
+
+  struct NonDormantFn
+  {
+    DECL_RETURN_TYPE(bool);
+    bool operator()(const TermQueryResult& res);
+  };
 };
 
 struct ClauseSResQueryResult
@@ -104,6 +116,12 @@ struct ClauseSResQueryResult
   Clause* clause;
   bool resolved;
   unsigned resolvedQueryLiteralIndex;
+
+  struct NonDormantFn
+  {
+    DECL_RETURN_TYPE(bool);
+    bool operator()(const ClauseSResQueryResult& res);
+  };
 };
 
 struct FormulaQueryResult
@@ -131,8 +149,11 @@ public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+
+  /** Make retrieval skip dormant clauses (see Clause::isDormant()) */
+  void skipDormantClauses() { _skipDormant = true; }
 protected:
-  Index() {}
+  Index() : _skipDormant(false) {}
 
   void onAddedToContainer(Clause* c)
   { handleClause(c, true); }
@@ -143,6 +164,7 @@ protected:
 
   //TODO: postponing index modifications during iteration (methods isBeingIterated() etc...)
 
+  bool _skipDormant;
 private:
   SubscriptionData _addedSD;
   SubscriptionData _removedSD;
@@ -21,6 +21,7 @@
  * Implements class IndexManager.
  */
 
+#include "Lib/Environment.hpp"
 #include "Lib/Exception.hpp"
 
 #include "Kernel/Grounder.hpp"
@@ -31,6 +32,7 @@
 #include "ArithmeticIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
 #include "GroundingIndex.hpp"
+#include "IndexTrace.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
 #include "TermIndex.hpp"
@@ -142,6 +144,33 @@ void IndexManager::provideIndex(IndexType t, Index* index)
   _store.set(t,e);
 }
 
+/**
+ * If the index_trace option is set, return @b is wrapped into a structure
+ * recording its operations, otherwise return @b is itself
+ */
+static LiteralIndexingStructure* traced(LiteralIndexingStructure* is, bool useConstraints=false)
+{
+  if(env.options->indexTrace().empty()) {
+    return is;
+  }
+  if(!IndexTrace::isRecording()) {
+    IndexTrace::startRecording(env.options->indexTrace());
+  }
+  return new RecordingLiteralIndexingStructure(is, useConstraints);
+}
+
+static TermIndexingStructure* traced(TermIndexingStructure* tis, IndexTrace::Structure structure,
+    bool useConstraints=false)
+{
+  if(env.options->indexTrace().empty()) {
+    return tis;
+  }
+  if(!IndexTrace::isRecording()) {
+    IndexTrace::startRecording(env.options->indexTrace());
+  }
+  return new RecordingTermIndexingStructure(tis, structure, useConstraints);
+}
+
 Index* IndexManager::create(IndexType t)
 {
   CALL("IndexManager::create");
@@ -154,7 +183,7 @@ Index* IndexManager::create(IndexType t)
   static bool useConstraints = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
   switch(t) {
   case GENERATING_SUBST_TREE:
-    is=new LiteralSubstitutionTree(useConstraints);
+    is=traced(new LiteralSubstitutionTree(useConstraints), useConstraints);
 #if VDEBUG
     //is->markTagged();
 #endif
@@ -163,29 +192,29 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SIMPLIFYING_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree());
     res=new SimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
   case SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree());
     res=new UnitClauseLiteralIndex(is);
     isGenerating = false;
     break;
   case GENERATING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree());
     res=new UnitClauseLiteralIndex(is);
     isGenerating = true;
     break;
   case GENERATING_NON_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree());
     res=new NonUnitClauseLiteralIndex(is);
     isGenerating = true;
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=traced(new TermSubstitutionTree(useConstraints), IndexTrace::SUBSTITUTION_TREE, useConstraints);
 #if VDEBUG
     //tis->markTagged();
 #endif
@@ -193,25 +222,25 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=traced(new TermSubstitutionTree(useConstraints), IndexTrace::SUBSTITUTION_TREE, useConstraints);
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
 
   case ACYCLICITY_INDEX:
-    tis = new TermSubstitutionTree();
+    tis = traced(new TermSubstitutionTree(), IndexTrace::SUBSTITUTION_TREE);
     res = new AcyclicityIndex(tis);
     isGenerating = true;
     break;
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    tis=traced(new TermSubstitutionTree(), IndexTrace::SUBSTITUTION_TREE);
     res=new DemodulationSubtermIndex(tis);
     isGenerating = false;
     break;
   case DEMODULATION_LHS_SUBST_TREE:
 //    tis=new TermSubstitutionTree();
-    tis=new CodeTreeTIS();
+    tis=traced(new CodeTreeTIS(), IndexTrace::CODE_TREE);
     res=new DemodulationLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = false;
     break;
@@ -222,14 +251,14 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case FW_SUBSUMPTION_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree());
 //    is=new CodeTreeLIS();
     res=new FwSubsSimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
   case REWRITE_RULE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree());
     res=new RewriteRuleIndex(is, _alg->getOrdering());
     isGenerating = false;
     break;
@@ -253,5 +282,8 @@ Index* IndexManager::create(IndexType t)
   else {
     res->attachContainer(_alg->getSimplifyingClauseContainer());
   }
+  if(_alg->getOptions().splittingLazyDeactivation()) {
+    res->skipDormantClauses();
+  }
   return res;
 }
@@ -0,0 +1,608 @@
+
+/*
+ * File IndexTrace.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file IndexTrace.cpp
+ * Implements class IndexTrace and the indexing structures recording into it.
+ *
+ * A trace file is a sequence of unsigned words in the byte order of the
+ * machine that wrote it: the magic number and the version, then the
+ * records of the operations, each starting with its length in words
+ * and a word holding the operation and the number of the index, then
+ * a zero word, and finally the sorts, functions and predicates of the
+ * signature with their types and names (padded to whole words), and
+ * the number of operations that could not be recorded.
+ */
+
+#include <fstream>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/System.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/CompressedClause.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "IndexTrace.hpp"
+
+namespace Indexing
+{
+
+using namespace std;
+
+/** "VIXT" read as a little-endian word */
+static const unsigned TRACE_MAGIC = 0x54584956;
+static const unsigned TRACE_VERSION = 1;
+/** number of words of records collected before they are written */
+static const size_t FLUSH_SIZE = 1<<20;
+
+bool IndexTrace::s_recording = false;
+vstring IndexTrace::s_fileName;
+Stack<unsigned> IndexTrace::s_buffer;
+unsigned IndexTrace::s_indexCnt = 0;
+unsigned IndexTrace::s_skipped = 0;
+
+const char* IndexTrace::operationName(Operation op)
+{
+  switch(op) {
+  case NEW_TERM_INDEX:
+    return "new term index";
+  case NEW_LITERAL_INDEX:
+    return "new literal index";
+  case INSERT:
+    return "insert";
+  case REMOVE:
+    return "remove";
+  case UNIFICATIONS:
+    return "unifications";
+  case UNIFICATIONS_WITH_CONSTRAINTS:
+    return "unifications with constraints";
+  case GENERALIZATIONS:
+    return "generalizations";
+  case INSTANCES:
+    return "instances";
+  case VARIANTS:
+    return "variants";
+  case GENERALIZATION_EXISTS:
+    return "generalization exists";
+  default:
+    ASSERTION_VIOLATION;
+  }
+  return "";
+}
+
+/**
+ * Start recording the operations into the file @b fileName. The file
+ * is complete when the process terminates.
+ */
+void IndexTrace::startRecording(vstring fileName)
+{
+  CALL("IndexTrace::startRecording");
+  ASS(!s_recording);
+
+  s_recording=true;
+  s_fileName=fileName;
+  s_buffer.push(TRACE_MAGIC);
+  s_buffer.push(TRACE_VERSION);
+  {
+    BYPASSING_ALLOCATOR;
+
+    ofstream out(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+    if(!out.is_open()) {
+      USER_ERROR("Cannot open index trace file for writing: "+fileName);
+    }
+  }
+  System::addTerminationHandler(finish);
+}
+
+/**
+ * Record the creation of an index and return its number
+ */
+unsigned IndexTrace::newIndex(bool literalIndex, Structure structure, bool useConstraints)
+{
+  CALL("IndexTrace::newIndex");
+
+  unsigned index=s_indexCnt++;
+  s_buffer.push(4);
+  s_buffer.push((literalIndex ? NEW_LITERAL_INDEX : NEW_TERM_INDEX) | (index<<8));
+  s_buffer.push(structure);
+  s_buffer.push(useConstraints);
+  return index;
+}
+
+void IndexTrace::recordTermOperation(Operation op, unsigned index, TermList t, Literal* lit, Clause* cls,
+    bool retrieveSubstitutions, unsigned results)
+{
+  CALL("IndexTrace::recordTermOperation");
+
+  size_t start=s_buffer.size();
+  s_buffer.push(0);
+  s_buffer.push(op | (index<<8));
+  if(op==INSERT || op==REMOVE) {
+    s_buffer.push(lit ? 1 : 0);
+    s_buffer.push(cls ? cls->number() : 0);
+    if(lit && !CompressedClause::encodeLiteral(lit, s_buffer)) {
+      s_buffer.truncate(start);
+      s_skipped++;
+      return;
+    }
+  }
+  else {
+    s_buffer.push(retrieveSubstitutions);
+    s_buffer.push(results);
+  }
+  if(!CompressedClause::encode(t, s_buffer)) {
+    s_buffer.truncate(start);
+    s_skipped++;
+    return;
+  }
+  s_buffer[start]=s_buffer.size()-start;
+  if(s_buffer.size()>FLUSH_SIZE) {
+    flush();
+  }
+}
+
+void IndexTrace::recordLiteralOperation(Operation op, unsigned index, Literal* lit, Clause* cls,
+    bool complementary, bool retrieveSubstitutions, unsigned results)
+{
+  CALL("IndexTrace::recordLiteralOperation");
+
+  size_t start=s_buffer.size();
+  s_buffer.push(0);
+  s_buffer.push(op | (index<<8));
+  if(op==INSERT || op==REMOVE) {
+    s_buffer.push(cls ? cls->number() : 0);
+  }
+  else {
+    s_buffer.push((complementary ? 1 : 0) | (retrieveSubstitutions ? 2 : 0));
+    s_buffer.push(results);
+  }
+  if(!CompressedClause::encodeLiteral(lit, s_buffer)) {
+    s_buffer.truncate(start);
+    s_skipped++;
+    return;
+  }
+  s_buffer[start]=s_buffer.size()-start;
+  if(s_buffer.size()>FLUSH_SIZE) {
+    flush();
+  }
+}
+
+/**
+ * Append the collected words to the trace file
+ */
+void IndexTrace::flush()
+{
+  CALL("IndexTrace::flush");
+
+  BYPASSING_ALLOCATOR;
+
+  ofstream out(s_fileName.c_str(), ios::out | ios::binary | ios::app);
+  out.write(reinterpret_cast<const char*>(s_buffer.begin()), s_buffer.size()*sizeof(unsigned));
+  out.close();
+  if(out.fail()) {
+    USER_ERROR("Cannot write index trace file: "+s_fileName);
+  }
+  s_buffer.reset();
+}
+
+static void pushName(Stack<unsigned>& words, const vstring& name)
+{
+  words.push(name.size());
+  for(size_t i=0; i<name.size(); i+=sizeof(unsigned)) {
+    unsigned w=0;
+    name.copy(reinterpret_cast<char*>(&w), sizeof(unsigned), i);
+    words.push(w);
+  }
+}
+
+/**
+ * Write the end of the records and the signature. Called when the
+ * process terminates.
+ */
+void IndexTrace::finish()
+{
+  CALL("IndexTrace::finish");
+
+  s_buffer.push(0);
+
+  unsigned sorts=env.sorts->count();
+  s_buffer.push(sorts);
+  for(unsigned i=0; i<sorts; i++) {
+    pushName(s_buffer, env.sorts->sortName(i));
+  }
+  unsigned functions=env.signature->functions();
+  s_buffer.push(functions);
+  for(unsigned i=0; i<functions; i++) {
+    OperatorType* type=env.signature->getFunction(i)->fnType();
+    s_buffer.push(type->arity());
+    s_buffer.push(type->result());
+    for(unsigned j=0; j<type->arity(); j++) {
+      s_buffer.push(type->arg(j));
+    }
+    pushName(s_buffer, env.signature->functionName(i));
+  }
+  unsigned predicates=env.signature->predicates();
+  s_buffer.push(predicates);
+  for(unsigned i=0; i<predicates; i++) {
+    OperatorType* type=env.signature->getPredicate(i)->predType();
+    s_buffer.push(type->arity());
+    for(unsigned j=0; j<type->arity(); j++) {
+      s_buffer.push(type->arg(j));
+    }
+    pushName(s_buffer, env.signature->predicateName(i));
+  }
+  s_buffer.push(s_skipped);
+  flush();
+}
+
+/**
+ * Reader of the words of a trace file, which reports a truncated
+ * file as a user error
+ */
+class IndexTraceReader
+{
+public:
+  IndexTraceReader(const unsigned* begin, const unsigned* end, vstring fileName)
+  : _cur(begin), _end(end), _fileName(fileName) {}
+
+  unsigned next()
+  {
+    need(1);
+    return *(_cur++);
+  }
+
+  vstring nextName()
+  {
+    unsigned len=next();
+    unsigned words=(len+sizeof(unsigned)-1)/sizeof(unsigned);
+    need(words);
+    vstring res(reinterpret_cast<const char*>(_cur), len);
+    _cur+=words;
+    return res;
+  }
+
+  /** Return the next @b n words and move past them */
+  const unsigned* skip(unsigned n)
+  {
+    need(n);
+    const unsigned* res=_cur;
+    _cur+=n;
+    return res;
+  }
+private:
+  void need(unsigned n)
+  {
+    if(static_cast<size_t>(_end-_cur)<n) {
+      USER_ERROR("Index trace file is truncated: "+_fileName);
+    }
+  }
+
+  const unsigned* _cur;
+  const unsigned* _end;
+  vstring _fileName;
+};
+
+/**
+ * Check that the symbol @b name number @b num, just added to the
+ * signature, got the same number as in the trace
+ */
+static void checkSymbol(unsigned num, unsigned expected, const vstring& name, vstring fileName)
+{
+  if(num!=expected) {
+    USER_ERROR("Symbol "+name+" of index trace "+fileName+" cannot be rebuilt");
+  }
+}
+
+/**
+ * Read the symbols at the end of a trace into the current signature.
+ * Symbols already in the signature must be the same as in the trace,
+ * others are added. Names that are taken by a symbol with a different
+ * number are made unique.
+ */
+static void readSignature(IndexTraceReader& rd, vstring fileName)
+{
+  unsigned sorts=rd.next();
+  for(unsigned i=0; i<sorts; i++) {
+    vstring name=rd.nextName();
+    if(i<env.sorts->count()) {
+      continue;
+    }
+    bool added;
+    unsigned sort=env.sorts->addSort(name, added, false);
+    if(!added) {
+      sort=env.sorts->addSort(name+"#"+Int::toString(i), false);
+    }
+    checkSymbol(sort, i, name, fileName);
+  }
+
+  static Stack<unsigned> argSorts;
+  unsigned functions=rd.next();
+  for(unsigned i=0; i<functions; i++) {
+    unsigned arity=rd.next();
+    unsigned result=rd.next();
+    argSorts.reset();
+    for(unsigned j=0; j<arity; j++) {
+      argSorts.push(rd.next());
+    }
+    vstring name=rd.nextName();
+    if(i<env.signature->functions()) {
+      checkSymbol(env.signature->functionArity(i)==arity ? i : functions, i, name, fileName);
+      continue;
+    }
+    bool added;
+    unsigned fn=env.signature->addFunction(name, arity, added);
+    if(!added) {
+      fn=env.signature->addFunction(name+"#"+Int::toString(i), arity);
+    }
+    checkSymbol(fn, i, name, fileName);
+    env.signature->getFunction(fn)->setType(OperatorType::getFunctionType(arity, argSorts.begin(), result));
+  }
+
+  unsigned predicates=rd.next();
+  for(unsigned i=0; i<predicates; i++) {
+    unsigned arity=rd.next();
+    argSorts.reset();
+    for(unsigned j=0; j<arity; j++) {
+      argSorts.push(rd.next());
+    }
+    vstring name=rd.nextName();
+    if(i<env.signature->predicates()) {
+      checkSymbol(env.signature->predicateArity(i)==arity ? i : predicates, i, name, fileName);
+      continue;
+    }
+    bool added;
+    unsigned pred=env.signature->addPredicate(name, arity, added);
+    if(!added) {
+      pred=env.signature->addPredicate(name+"#"+Int::toString(i), arity);
+    }
+    checkSymbol(pred, i, name, fileName);
+    env.signature->getPredicate(pred)->setType(OperatorType::getPredicateType(arity, argSorts.begin()));
+  }
+}
+
+/**
+ * Read the trace from the file @b fileName into @b entries, after
+ * adding its symbols to the signature.
+ */
+void IndexTrace::load(vstring fileName, Stack<Entry>& entries)
+{
+  CALL("IndexTrace::load");
+
+  Stack<unsigned> words;
+  {
+    BYPASSING_ALLOCATOR;
+
+    ifstream in(fileName.c_str(), ios::in | ios::binary);
+    if(!in.is_open()) {
+      USER_ERROR("Cannot open index trace file: "+fileName);
+    }
+    unsigned w;
+    while(in.read(reinterpret_cast<char*>(&w), sizeof(unsigned))) {
+      words.push(w);
+    }
+  }
+
+  IndexTraceReader rd(words.begin(), words.end(), fileName);
+  if(rd.next()!=TRACE_MAGIC || rd.next()!=TRACE_VERSION) {
+    USER_ERROR("Not an index trace file: "+fileName);
+  }
+  const unsigned* records=words.begin()+2;
+  //the symbols follow the records
+  unsigned len;
+  while((len=rd.next())!=0) {
+    rd.skip(len-1);
+  }
+  readSignature(rd, fileName);
+  unsigned skipped=rd.next();
+  if(skipped) {
+    env.beginOutput();
+    env.out()<<"% "<<skipped<<" operations were not recorded in "<<fileName<<endl;
+    env.endOutput();
+  }
+
+  Stack<bool> literalIndex;
+  for(const unsigned* rec=records; *rec; rec+=*rec) {
+    const unsigned* code=rec+1;
+    Entry e;
+    e.op=static_cast<Operation>(*code&0xff);
+    e.index=*(code++)>>8;
+    e.clause=0;
+    e.lit=0;
+    e.complementary=false;
+    e.retrieveSubstitutions=false;
+    e.results=0;
+    switch(e.op) {
+    case NEW_TERM_INDEX:
+    case NEW_LITERAL_INDEX:
+      ASS_EQ(e.index, literalIndex.size());
+      literalIndex.push(e.op==NEW_LITERAL_INDEX);
+      e.structure=static_cast<Structure>(*(code++));
+      e.useConstraints=*(code++);
+      break;
+    case INSERT:
+    case REMOVE:
+      if(literalIndex[e.index]) {
+        e.clause=*(code++);
+        e.lit=CompressedClause::decodeLiteral(code);
+      }
+      else {
+        bool hasLiteral=*(code++);
+        e.clause=*(code++);
+        if(hasLiteral) {
+          e.lit=CompressedClause::decodeLiteral(code);
+        }
+        e.term=CompressedClause::decodeTerm(code);
+      }
+      break;
+    default:
+      if(literalIndex[e.index]) {
+        e.complementary=*code&1;
+        e.retrieveSubstitutions=*(code++)&2;
+        e.results=*(code++);
+        e.lit=CompressedClause::decodeLiteral(code);
+      }
+      else {
+        e.retrieveSubstitutions=*(code++);
+        e.results=*(code++);
+        e.term=CompressedClause::decodeTerm(code);
+      }
+    }
+    ASS_EQ(code, rec+*rec);
+    entries.push(e);
+  }
+}
+
+RecordingTermIndexingStructure::RecordingTermIndexingStructure(TermIndexingStructure* inner,
+    IndexTrace::Structure structure, bool useConstraints)
+: _inner(inner)
+{
+  CALL("RecordingTermIndexingStructure::RecordingTermIndexingStructure");
+
+  _index=IndexTrace::newIndex(false, structure, useConstraints);
+}
+
+RecordingTermIndexingStructure::~RecordingTermIndexingStructure()
+{
+  delete _inner;
+}
+
+void RecordingTermIndexingStructure::insert(TermList t, Literal* lit, Clause* cls)
+{
+  IndexTrace::recordTermOperation(IndexTrace::INSERT, _index, t, lit, cls, false, 0);
+  _inner->insert(t, lit, cls);
+}
+
+void RecordingTermIndexingStructure::remove(TermList t, Literal* lit, Clause* cls)
+{
+  IndexTrace::recordTermOperation(IndexTrace::REMOVE, _index, t, lit, cls, false, 0);
+  _inner->remove(t, lit, cls);
+}
+
+//the queries are run twice, first to count the results for the trace
+
+TermQueryResultIterator RecordingTermIndexingStructure::getUnifications(TermList t,
+    bool retrieveSubstitutions)
+{
+  IndexTrace::recordTermOperation(IndexTrace::UNIFICATIONS, _index, t, 0, 0, retrieveSubstitutions,
+      countIteratorElements(_inner->getUnifications(t, retrieveSubstitutions)));
+  return _inner->getUnifications(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getUnificationsWithConstraints(TermList t,
+    bool retrieveSubstitutions)
+{
+  IndexTrace::recordTermOperation(IndexTrace::UNIFICATIONS_WITH_CONSTRAINTS, _index, t, 0, 0,
+      retrieveSubstitutions, countIteratorElements(_inner->getUnificationsWithConstraints(t, retrieveSubstitutions)));
+  return _inner->getUnificationsWithConstraints(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getGeneralizations(TermList t,
+    bool retrieveSubstitutions)
+{
+  IndexTrace::recordTermOperation(IndexTrace::GENERALIZATIONS, _index, t, 0, 0, retrieveSubstitutions,
+      countIteratorElements(_inner->getGeneralizations(t, retrieveSubstitutions)));
+  return _inner->getGeneralizations(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getInstances(TermList t,
+    bool retrieveSubstitutions)
+{
+  IndexTrace::recordTermOperation(IndexTrace::INSTANCES, _index, t, 0, 0, retrieveSubstitutions,
+      countIteratorElements(_inner->getInstances(t, retrieveSubstitutions)));
+  return _inner->getInstances(t, retrieveSubstitutions);
+}
+
+bool RecordingTermIndexingStructure::generalizationExists(TermList t)
+{
+  bool res=_inner->generalizationExists(t);
+  IndexTrace::recordTermOperation(IndexTrace::GENERALIZATION_EXISTS, _index, t, 0, 0, false, res);
+  return res;
+}
+
+RecordingLiteralIndexingStructure::RecordingLiteralIndexingStructure(LiteralIndexingStructure* inner,
+    bool useConstraints)
+: _inner(inner)
+{
+  CALL("RecordingLiteralIndexingStructure::RecordingLiteralIndexingStructure");
+
+  _index=IndexTrace::newIndex(true, IndexTrace::SUBSTITUTION_TREE, useConstraints);
+}
+
+RecordingLiteralIndexingStructure::~RecordingLiteralIndexingStructure()
+{
+  delete _inner;
+}
+
+void RecordingLiteralIndexingStructure::insert(Literal* lit, Clause* cls)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::INSERT, _index, lit, cls, false, false, 0);
+  _inner->insert(lit, cls);
+}
+
+void RecordingLiteralIndexingStructure::remove(Literal* lit, Clause* cls)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::REMOVE, _index, lit, cls, false, false, 0);
+  _inner->remove(lit, cls);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getUnifications(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::UNIFICATIONS, _index, lit, 0, complementary,
+      retrieveSubstitutions, countIteratorElements(_inner->getUnifications(lit, complementary, retrieveSubstitutions)));
+  return _inner->getUnifications(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getUnificationsWithConstraints(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::UNIFICATIONS_WITH_CONSTRAINTS, _index, lit, 0, complementary,
+      retrieveSubstitutions,
+      countIteratorElements(_inner->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions)));
+  return _inner->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getGeneralizations(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::GENERALIZATIONS, _index, lit, 0, complementary,
+      retrieveSubstitutions, countIteratorElements(_inner->getGeneralizations(lit, complementary, retrieveSubstitutions)));
+  return _inner->getGeneralizations(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getInstances(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::INSTANCES, _index, lit, 0, complementary,
+      retrieveSubstitutions, countIteratorElements(_inner->getInstances(lit, complementary, retrieveSubstitutions)));
+  return _inner->getInstances(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getVariants(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  IndexTrace::recordLiteralOperation(IndexTrace::VARIANTS, _index, lit, 0, complementary,
+      retrieveSubstitutions, countIteratorElements(_inner->getVariants(lit, complementary, retrieveSubstitutions)));
+  return _inner->getVariants(lit, complementary, retrieveSubstitutions);
+}
+
+}
@@ -0,0 +1,194 @@
+
+/*
+ * File IndexTrace.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file IndexTrace.hpp
+ * Defines class IndexTrace and the indexing structures recording into it.
+ */
+
+#ifndef __IndexTrace__
+#define __IndexTrace__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Term.hpp"
+
+#include "LiteralIndexingStructure.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * A trace of the operations performed on the term and literal indexing
+ * structures during a run (see the index_trace option), which can be
+ * replayed on other implementations of the structures by vindexreplay.
+ *
+ * Terms and literals are stored in the code of CompressedClause, and
+ * the trace ends with the symbols of the signature, so that the replay
+ * can rebuild them.
+ */
+class IndexTrace
+{
+public:
+  enum Operation {
+    NEW_TERM_INDEX,
+    NEW_LITERAL_INDEX,
+    INSERT,
+    REMOVE,
+    UNIFICATIONS,
+    UNIFICATIONS_WITH_CONSTRAINTS,
+    GENERALIZATIONS,
+    INSTANCES,
+    VARIANTS,
+    GENERALIZATION_EXISTS,
+    OPERATION_COUNT
+  };
+
+  /** The implementations of the indexing structures */
+  enum Structure {
+    SUBSTITUTION_TREE,
+    CODE_TREE
+  };
+
+  /** An operation read from a trace */
+  struct Entry
+  {
+    Operation op;
+    /** the number of the index the operation is performed on */
+    unsigned index;
+
+    /** for NEW_TERM_INDEX and NEW_LITERAL_INDEX */
+    Structure structure;
+    bool useConstraints;
+
+    /** for INSERT and REMOVE, the number of the clause or zero */
+    unsigned clause;
+    /** the literal, or zero if the term was inserted without one */
+    Literal* lit;
+    /** the term of a term index */
+    TermList term;
+    bool complementary;
+    bool retrieveSubstitutions;
+    /** the number of results of a query in the recorded run */
+    unsigned results;
+  };
+
+  static void startRecording(vstring fileName);
+  static bool isRecording() { return s_recording; }
+
+  static unsigned newIndex(bool literalIndex, Structure structure, bool useConstraints);
+  static void recordTermOperation(Operation op, unsigned index, TermList t, Literal* lit, Clause* cls,
+      bool retrieveSubstitutions, unsigned results);
+  static void recordLiteralOperation(Operation op, unsigned index, Literal* lit, Clause* cls,
+      bool complementary, bool retrieveSubstitutions, unsigned results);
+
+  static void load(vstring fileName, Stack<Entry>& entries);
+
+  static const char* operationName(Operation op);
+
+private:
+  static void flush();
+  static void finish();
+
+  static bool s_recording;
+  static vstring s_fileName;
+  /** records not written to the file yet */
+  static Stack<unsigned> s_buffer;
+  static unsigned s_indexCnt;
+  /** operations that could not be encoded */
+  static unsigned s_skipped;
+};
+
+/**
+ * Term indexing structure that records the operations it performs
+ * on another one into the IndexTrace
+ */
+class RecordingTermIndexingStructure
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(RecordingTermIndexingStructure);
+  USE_ALLOCATOR(RecordingTermIndexingStructure);
+
+  RecordingTermIndexingStructure(TermIndexingStructure* inner, IndexTrace::Structure structure,
+      bool useConstraints);
+  ~RecordingTermIndexingStructure();
+
+  void insert(TermList t, Literal* lit, Clause* cls);
+  void remove(TermList t, Literal* lit, Clause* cls);
+
+  TermQueryResultIterator getUnifications(TermList t, bool retrieveSubstitutions);
+  TermQueryResultIterator getUnificationsWithConstraints(TermList t, bool retrieveSubstitutions);
+  TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions);
+  TermQueryResultIterator getInstances(TermList t, bool retrieveSubstitutions);
+  bool generalizationExists(TermList t);
+
+#if VDEBUG
+  void markTagged() { _inner->markTagged(); }
+#endif
+
+private:
+  TermIndexingStructure* _inner;
+  unsigned _index;
+};
+
+/**
+ * Literal indexing structure that records the operations it performs
+ * on another one into the IndexTrace
+ */
+class RecordingLiteralIndexingStructure
+: public LiteralIndexingStructure
+{
+public:
+  CLASS_NAME(RecordingLiteralIndexingStructure);
+  USE_ALLOCATOR(RecordingLiteralIndexingStructure);
+
+  RecordingLiteralIndexingStructure(LiteralIndexingStructure* inner, bool useConstraints);
+  ~RecordingLiteralIndexingStructure();
+
+  void insert(Literal* lit, Clause* cls);
+  void remove(Literal* lit, Clause* cls);
+
+  SLQueryResultIterator getAll() { return _inner->getAll(); }
+  SLQueryResultIterator getUnifications(Literal* lit, bool complementary, bool retrieveSubstitutions);
+  SLQueryResultIterator getUnificationsWithConstraints(Literal* lit, bool complementary,
+      bool retrieveSubstitutions);
+  SLQueryResultIterator getGeneralizations(Literal* lit, bool complementary, bool retrieveSubstitutions);
+  SLQueryResultIterator getInstances(Literal* lit, bool complementary, bool retrieveSubstitutions);
+  SLQueryResultIterator getVariants(Literal* lit, bool complementary, bool retrieveSubstitutions);
+
+#if VDEBUG
+  vstring toString() { return _inner->toString(); }
+  void markTagged() { _inner->markTagged(); }
+#endif
+
+private:
+  LiteralIndexingStructure* _inner;
+  unsigned _index;
+};
+
+}
+
+#endif // __IndexTrace__
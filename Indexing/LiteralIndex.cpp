@@ -21,6 +21,8 @@
  * Implements class LiteralIndex.
  */
 
+#include "Lib/Metaiterators.hpp"
+
 #include "Kernel/Clause.hpp"
 #include "Kernel/LiteralComparators.hpp"
 #include "Kernel/Matcher.hpp"
@@ -44,31 +46,31 @@ LiteralIndex::~LiteralIndex()
 
 SLQueryResultIterator LiteralIndex::getAll()
 {
-  return _is->getAll();
+  return filterDormant(_is->getAll());
 }
 
 SLQueryResultIterator LiteralIndex::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
-  return _is->getUnifications(lit, complementary, retrieveSubstitutions);
+  return filterDormant(_is->getUnifications(lit, complementary, retrieveSubstitutions));
 }
 
 SLQueryResultIterator LiteralIndex::getUnificationsWithConstraints(Literal* lit,
           bool complementary, bool retrieveSubstitutions)
 {
-  return _is->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions);
+  return filterDormant(_is->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions));
 }
 
 SLQueryResultIterator LiteralIndex::getGeneralizations(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
-  return _is->getGeneralizations(lit, complementary, retrieveSubstitutions);
+  return filterDormant(_is->getGeneralizations(lit, complementary, retrieveSubstitutions));
 }
 
 SLQueryResultIterator LiteralIndex::getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
-  return _is->getInstances(lit, complementary, retrieveSubstitutions);
+  return filterDormant(_is->getInstances(lit, complementary, retrieveSubstitutions));
 }
 
 size_t LiteralIndex::getUnificationCount(Literal* lit, bool complementary)
@@ -76,6 +78,18 @@ size_t LiteralIndex::getUnificationCount(Literal* lit, bool complementary)
   return _is->getUnificationCount(lit, complementary);
 }
 
+/**
+ * Drop results with dormant clauses from @b it, if this index
+ * was asked to do so
+ */
+SLQueryResultIterator LiteralIndex::filterDormant(SLQueryResultIterator it)
+{
+  if(!_skipDormant) {
+    return it;
+  }
+  return pvi( getFilteredIterator(it, SLQueryResult::NonDormantFn()) );
+}
+
 void LiteralIndex::handleLiteral(Literal* lit, Clause* cl, bool add)
 {
   CALL("LiteralIndex::handleLiteral");
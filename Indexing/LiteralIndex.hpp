@@ -61,6 +61,7 @@ protected:
   LiteralIndex(LiteralIndexingStructure* is) : _is(is) {}
 
   void handleLiteral(Literal* lit, Clause* cl, bool add);
+  SLQueryResultIterator filterDormant(SLQueryResultIterator it);
 
   LiteralIndexingStructure* _is;
 };
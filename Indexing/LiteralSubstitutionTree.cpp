@@ -30,6 +30,8 @@
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Term.hpp"
 
+#include "TermSharing.hpp"
+
 #include "LiteralSubstitutionTree.hpp"
 
 namespace Indexing
@@ -66,6 +68,14 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
   } else {
     SubstitutionTree::remove(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
   }
+  if(normLit!=lit) {
+    // the tree refers to the subterms of normLit, which the clause does not contain
+    if(insert) {
+      env.sharing->pin(normLit);
+    } else {
+      env.sharing->unpin(normLit);
+    }
+  }
 }
 
 SLQueryResultIterator LiteralSubstitutionTree::getUnifications(Literal* lit,
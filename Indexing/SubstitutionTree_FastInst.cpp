@@ -462,6 +462,17 @@ bool SubstitutionTree::InstMatcher::matchNext(unsigned specVar, TermList nodeTer
     goto finish;
   }
 
+  if(nodeTerm.isTerm() && nodeTerm.term()->shared() && tsBinding.q && tsBinding.t.isTerm()) {
+    //the node term is a subterm of the stored terms, so it must be an instance
+    //of the query subterm
+    Term* nt=nodeTerm.term();
+    Term* qt=tsBinding.t.term();
+    if(nt->functor()!=qt->functor() || !nt->couldArgsBeInstanceOf(qt)) {
+      success=false;
+      goto finish;
+    }
+  }
+
   static Stack<pair<TermSpec,TermSpec> > toDo;
   static DisagreementSetIterator dsit;
 
@@ -22,6 +22,7 @@
  */
 
 #include "Lib/DHSet.hpp"
+#include "Lib/Metaiterators.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/EqHelper.hpp"
@@ -45,27 +46,38 @@ TermIndex::~TermIndex()
 TermQueryResultIterator TermIndex::getUnifications(TermList t,
 	  bool retrieveSubstitutions)
 {
-  return _is->getUnifications(t, retrieveSubstitutions);
+  return filterDormant(_is->getUnifications(t, retrieveSubstitutions));
 }
 
 TermQueryResultIterator TermIndex::getUnificationsWithConstraints(TermList t,
           bool retrieveSubstitutions)
 {
-  return _is->getUnificationsWithConstraints(t, retrieveSubstitutions);
+  return filterDormant(_is->getUnificationsWithConstraints(t, retrieveSubstitutions));
 }
 
 TermQueryResultIterator TermIndex::getGeneralizations(TermList t,
 	  bool retrieveSubstitutions)
 {
-  return _is->getGeneralizations(t, retrieveSubstitutions);
+  return filterDormant(_is->getGeneralizations(t, retrieveSubstitutions));
 }
 
 TermQueryResultIterator TermIndex::getInstances(TermList t,
 	  bool retrieveSubstitutions)
 {
-  return _is->getInstances(t, retrieveSubstitutions);
+  return filterDormant(_is->getInstances(t, retrieveSubstitutions));
 }
 
+/**
+ * Drop results with dormant clauses from @b it, if this index
+ * was asked to do so
+ */
+TermQueryResultIterator TermIndex::filterDormant(TermQueryResultIterator it)
+{
+  if(!_skipDormant) {
+    return it;
+  }
+  return pvi( getFilteredIterator(it, TermQueryResult::NonDormantFn()) );
+}
 
 void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
 {
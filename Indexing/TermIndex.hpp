@@ -50,6 +50,8 @@ public:
 protected:
   TermIndex(TermIndexingStructure* is) : _is(is) {}
 
+  TermQueryResultIterator filterDormant(TermQueryResultIterator it);
+
   TermIndexingStructure* _is;
 };
 
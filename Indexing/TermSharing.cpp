@@ -25,10 +25,16 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/TimeCounter.hpp"
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
 #include "Kernel/Signature.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Sorts.hpp"
+#include "Kernel/SubformulaIterator.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 #include "TermSharing.hpp"
@@ -46,7 +52,9 @@ TermSharing::TermSharing()
     _totalLiterals(0),
     // _groundLiterals(0), //MS: unused
     _literalInsertions(0),
-    _termInsertions(0)
+    _termInsertions(0),
+    _collectionEnabled(false),
+    _collections(0)
 {
   CALL("TermSharing::TermSharing");
 }
@@ -103,6 +111,9 @@ Term* TermSharing::insert(Term* t)
     bool hasInterpretedConstants=t->arity()==0 &&
 	env.signature->getFunction(t->functor())->interpreted();
     Color color = COLOR_TRANSPARENT;
+#if USE_MATCH_TAG
+    t->matchTag().initHead(t->functor(), false);
+#endif
     for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
       if (tt->isVar()) {
           ASS(tt->isOrdinaryVar());
@@ -117,6 +128,9 @@ Term* TermSharing::insert(Term* t)
     
           vars += r->vars();
           weight += r->weight();
+#if USE_MATCH_TAG
+          t->matchTag().addArgument(r->matchTag());
+#endif
           if (env.colorUsed) {
               color = static_cast<Color>(color | r->color());
           }
@@ -136,6 +150,9 @@ Term* TermSharing::insert(Term* t)
       
     t->setInterpretedConstantsPresence(hasInterpretedConstants);
     _totalTerms++;
+    if (_collectionEnabled) {
+      _collectable.push(t);
+    }
      
     ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
     if (!SortHelper::areImmediateSortsValid(t)){
@@ -184,6 +201,9 @@ Literal* TermSharing::insert(Literal* t)
     unsigned vars = 0;
     Color color = COLOR_TRANSPARENT;
     bool hasInterpretedConstants=false;
+#if USE_MATCH_TAG
+    t->matchTag().initHead(t->functor(), true);
+#endif
     for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
       if (tt->isVar()) {
 	ASS(tt->isOrdinaryVar());
@@ -195,6 +215,9 @@ Literal* TermSharing::insert(Literal* t)
 	Term* r = tt->term();
 	vars += r->vars();
 	weight += r->weight();
+#if USE_MATCH_TAG
+	t->matchTag().addArgument(r->matchTag());
+#endif
 	if (env.colorUsed) {
 	  ASS(color == COLOR_TRANSPARENT || r->color() == COLOR_TRANSPARENT || color == r->color());
 	  color = static_cast<Color>(color | r->color());
@@ -214,6 +237,9 @@ Literal* TermSharing::insert(Literal* t)
     }
     t->setInterpretedConstantsPresence(hasInterpretedConstants);
     _totalLiterals++;
+    if (_collectionEnabled) {
+      _collectable.push(t);
+    }
 
     ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
     if (!SortHelper::areImmediateSortsValid(t)){
@@ -257,11 +283,17 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
   if (s == t) {
     t->markShared();
     t->setWeight(3);
+#if USE_MATCH_TAG
+    t->matchTag().initHead(t->functor(), true);
+#endif
     if (env.colorUsed) {
       t->setColor(COLOR_TRANSPARENT);
     }
     t->setInterpretedConstantsPresence(false);
     _totalLiterals++;
+    if (_collectionEnabled) {
+      _collectable.push(t);
+    }
   }
   else {
     t->destroy();
@@ -269,6 +301,158 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
   return s;
 } // TermSharing::insertVariableEquality
 
+/**
+ * Allow collect() to destroy the terms and literals inserted from now on.
+ * The units are tracked from now on, as the terms in use are those
+ * contained in live units, see collect().
+ */
+void TermSharing::enableCollection()
+{
+  CALL("TermSharing::enableCollection");
+
+  _collectionEnabled = true;
+  Unit::trackLiveUnits();
+}
+
+/**
+ * Keep the term or literal @b t and its subterms for good, even if
+ * they are not contained in any live unit. Has to be called for the
+ * terms that are stored anywhere else than in units, and kept after
+ * the current step of the saturation algorithm.
+ *
+ * Pins are counted, the term can be collected again once unpin() is
+ * called as many times as pin().
+ */
+void TermSharing::pin(Term* t)
+{
+  CALL("TermSharing::pin");
+  ASS(t->shared());
+
+  if (_collectionEnabled) {
+    unsigned* cnt;
+    _pinned.getValuePtr(t, cnt, 0);
+    (*cnt)++;
+  }
+}
+
+/**
+ * Undo one call to pin() for @b t
+ */
+void TermSharing::unpin(Term* t)
+{
+  CALL("TermSharing::unpin");
+
+  if (!_collectionEnabled) {
+    return;
+  }
+  unsigned* cnt;
+  if (_pinned.getValuePtr(t, cnt, 0) || --(*cnt)==0) {
+    // pinned before collection was enabled, or not pinned any more
+    _pinned.remove(t);
+  }
+}
+
+/**
+ * Destroy the terms and literals inserted since enableCollection() that
+ * are not contained in live units and were not pinned. Return their number.
+ *
+ * No other structure may refer to the destroyed terms, so this can be
+ * called only when no inference is in progress.
+ */
+unsigned TermSharing::collect()
+{
+  CALL("TermSharing::collect");
+  ASS(_collectionEnabled);
+  ASS(_marked.isEmpty());
+
+  TimeCounter tc(TC_TERM_COLLECTION);
+
+  DHSet<Unit*>::Iterator uit(*Unit::liveUnits());
+  while (uit.hasNext()) {
+    Unit* u = uit.next();
+    if (u->isClause()) {
+      Clause* cl = static_cast<Clause*>(u);
+      unsigned clen = cl->length();
+      for (unsigned i = 0; i < clen; i++) {
+        markLive((*cl)[i]);
+      }
+      continue;
+    }
+    SubformulaIterator sfit(static_cast<FormulaUnit*>(u)->formula());
+    while (sfit.hasNext()) {
+      Formula* f = sfit.next();
+      if (f->connective() == LITERAL) {
+        markLive(f->literal());
+      }
+      else if (f->connective() == BOOL_TERM && f->getBooleanTerm().isTerm()) {
+        markLive(f->getBooleanTerm().term());
+      }
+    }
+  }
+  DHMap<Term*,unsigned>::Iterator pit(_pinned);
+  while (pit.hasNext()) {
+    markLive(pit.nextKey());
+  }
+
+  // first remove all unmarked ones from the sets, as the hash of
+  // a term depends on its arguments
+  static Stack<Term*> dead;
+  unsigned kept = 0;
+  for (unsigned i = 0; i < _collectable.size(); i++) {
+    Term* t = _collectable[i];
+    if (t->_liveMark) {
+      _collectable[kept++] = t;
+      continue;
+    }
+    if (t->isLiteral()) {
+      ALWAYS(_literals.remove(static_cast<Literal*>(t)));
+      _totalLiterals--;
+    }
+    else {
+      ALWAYS(_terms.remove(t));
+      _totalTerms--;
+    }
+    dead.push(t);
+  }
+  _collectable.truncate(kept);
+
+  unsigned res = dead.size();
+  while (dead.isNonEmpty()) {
+    Term* t = dead.pop();
+    t->_args[0]._info.shared = 0;
+    t->destroy();
+  }
+  while (_marked.isNonEmpty()) {
+    _marked.pop()->_liveMark = 0;
+  }
+  _collections++;
+  return res;
+} // TermSharing::collect
+
+/**
+ * Mark @b t and its subterms as being in use
+ */
+void TermSharing::markLive(Term* t)
+{
+  CALL("TermSharing::markLive");
+
+  static Stack<Term*> toMark;
+  toMark.push(t);
+  while (toMark.isNonEmpty()) {
+    Term* s = toMark.pop();
+    if (s->_liveMark) {
+      continue;
+    }
+    s->_liveMark = 1;
+    _marked.push(s);
+    for (TermList* ts = s->args(); !ts->isEmpty(); ts = ts->next()) {
+      if (ts->isTerm()) {
+        toMark.push(ts->term());
+      }
+    }
+  }
+} // TermSharing::markLive
+
 /**
  * Insert a new term and all its unshared subterms
  * in the index, and return the result.
@@ -26,7 +26,9 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
+#include "Lib/DHMap.hpp"
 #include "Lib/Set.hpp"
+#include "Lib/Stack.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -53,6 +55,15 @@ public:
 
   Literal* tryGetOpposite(Literal* l);
 
+  void enableCollection();
+  /** True if enableCollection() was called */
+  bool collectionEnabled() const { return _collectionEnabled; }
+  /** The number of times collect() was called */
+  unsigned collections() const { return _collections; }
+  void pin(Term* t);
+  void unpin(Term* t);
+  unsigned collect();
+
   /** The hash function of this literal */
   inline static unsigned hash(const Literal* l)
   { return l->hash(); }
@@ -75,6 +86,7 @@ public:
 
 private:
   bool argNormGt(TermList t1, TermList t2);
+  void markLive(Term* t);
 
   /** The set storing all terms */
   Set<Term*,TermSharing> _terms;
@@ -92,6 +104,17 @@ private:
   unsigned _literalInsertions;
   /** Number of term insertions */
   unsigned _termInsertions;
+
+  bool _collectionEnabled;
+  unsigned _collections;
+  /** Terms and literals inserted since collection was enabled, the
+   * only ones that collect() may destroy */
+  Stack<Term*> _collectable;
+  /** Terms and literals kept by collect() even if no live unit contains them,
+   * with the number of times they were pinned */
+  DHMap<Term*,unsigned> _pinned;
+  /** Terms and literals marked by the running collect() */
+  Stack<Term*> _marked;
 }; // class TermSharing
 
 } // namespace Indexing
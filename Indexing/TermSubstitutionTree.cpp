@@ -33,6 +33,8 @@
 
 #include "Shell/Options.hpp"
 
+#include "TermSharing.hpp"
+
 #include "TermSubstitutionTree.hpp"
 
 namespace Indexing
@@ -89,6 +91,14 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
     } else {
       SubstitutionTree::remove(&_nodes[rootNodeIndex], svBindings, ld);
     }
+    if(normTerm!=term) {
+      // the tree refers to the subterms of normTerm, which the clause does not contain
+      if(insert) {
+        env.sharing->pin(normTerm);
+      } else {
+        env.sharing->unpin(normTerm);
+      }
+    }
   }
 }
 
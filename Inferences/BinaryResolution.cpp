@@ -34,6 +34,7 @@
 #include "Kernel/Unit.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/LiteralSelector.hpp"
+#include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SortHelper.hpp"
 
 #include "Indexing/Index.hpp"
@@ -65,6 +66,8 @@ void BinaryResolution::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(GENERATING_SUBST_TREE) );
 
   _unificationWithAbstraction = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
+  //recipes cannot recompute unifications with abstraction
+  _lazy = _salg->lazyGeneration() && !_unificationWithAbstraction;
 }
 
 void BinaryResolution::detach()
@@ -111,6 +114,11 @@ struct BinaryResolution::ResultFn
     SLQueryResult& qr = arg.second;
     Literal* resLit = arg.first;
 
+    //resolutions of two unit clauses are not deferred, they yield the refutation
+    if(_parent._lazy && _cl->length()+qr.clause->length()>2) {
+      _parent.deferResolution(_cl, resLit, qr);
+      return 0;
+    }
     return BinaryResolution::generateClause(_cl, resLit, qr, _parent.getOptions(), _limits, _afterCheck ? _ord : 0, &_selector);
   }
 private:
@@ -122,6 +130,70 @@ private:
   BinaryResolution& _parent;
 };
 
+/**
+ * Resolution whose conclusion is built only when the recipe is
+ * selected from the passive container. The unifier is not kept,
+ * it is computed again from the resolved literals.
+ */
+class BinaryResolution::Recipe
+: public ClauseRecipe
+{
+public:
+  CLASS_NAME(BinaryResolution::Recipe);
+  USE_ALLOCATOR(BinaryResolution::Recipe);
+
+  Recipe(BinaryResolution& parent, Clause* queryCl, Literal* queryLit,
+      Clause* resCl, Literal* resLit, unsigned weight)
+  : ClauseRecipe(queryCl, resCl, weight), _parent(parent),
+    _queryLit(queryLit), _resLit(resLit) {}
+
+  Clause* materialise()
+  {
+    CALL("BinaryResolution::Recipe::materialise");
+    ASS(premisesActive());
+
+    RobSubstitution subst;
+    ALWAYS(subst.unifyArgs(_queryLit, 0, _resLit, 1));
+    SLQueryResult qr(_resLit, _premise2, ResultSubstitution::fromSubstitution(&subst, 0, 1));
+
+    SaturationAlgorithm* salg = _parent._salg;
+    bool afterCheck = _parent.getOptions().literalMaximalityAftercheck() && salg->getLiteralSelector().isBGComplete();
+    return generateClause(_premise1, _queryLit, qr, _parent.getOptions(), salg->getLimits(),
+	afterCheck ? &salg->getOrdering() : 0, &salg->getLiteralSelector());
+  }
+private:
+  BinaryResolution& _parent;
+  Literal* _queryLit;
+  Literal* _resLit;
+};
+
+/**
+ * Pass a recipe of the resolution to the saturation algorithm instead of
+ * building the conclusion. The weight of the recipe is the weight of the
+ * conclusion, computed without building its literals.
+ */
+void BinaryResolution::deferResolution(Clause* queryCl, Literal* queryLit, SLQueryResult& qr)
+{
+  CALL("BinaryResolution::deferResolution");
+
+  unsigned weight = 0;
+  unsigned clength = queryCl->length();
+  for(unsigned i=0;i<clength;i++) {
+    Literal* curr=(*queryCl)[i];
+    if(curr!=queryLit) {
+      weight+=qr.substitution->getApplicationWeight(curr, false);
+    }
+  }
+  unsigned dlength = qr.clause->length();
+  for(unsigned i=0;i<dlength;i++) {
+    Literal* curr=(*qr.clause)[i];
+    if(curr!=qr.literal) {
+      weight+=qr.substitution->getApplicationWeight(curr, true);
+    }
+  }
+  _salg->addNewRecipe(new Recipe(*this, queryCl, queryLit, qr.clause, qr.literal, Int::max(weight, 1)));
+}
+
 /**
  * Ordering aftercheck is performed iff ord is not 0,
  * in which case also ls is assumed to be not 0.
@@ -44,6 +44,7 @@
 #include "Indexing/Index.hpp"
 #include "Indexing/IndexManager.hpp"
 #include "Indexing/TermIndex.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -72,11 +73,59 @@ void ForwardDemodulation::attach(SaturationAlgorithm* salg)
 void ForwardDemodulation::detach()
 {
   CALL("ForwardDemodulation::detach");
+  destroyGreaterConstraints();
   _index=0;
   _salg->getIndexManager()->release(DEMODULATION_LHS_SUBST_TREE);
   ForwardSimplificationEngine::detach();
 }
 
+void ForwardDemodulation::destroyGreaterConstraints()
+{
+  CALL("ForwardDemodulation::destroyGreaterConstraints");
+
+  for(unsigned i=0;i<2;i++) {
+    DHMap<Literal*, Ordering::GreaterConstraint*>::Iterator cit(_greaterConstraints[i]);
+    while(cit.hasNext()) {
+      delete cit.next();
+    }
+    _greaterConstraints[i].reset();
+  }
+}
+
+/**
+ * Return the precompiled test of @b lhs being greater than the other
+ * side of @b eq, or zero if the ordering does not provide one
+ */
+Ordering::GreaterConstraint* ForwardDemodulation::getGreaterConstraint(Literal* eq, TermList lhs)
+{
+  CALL("ForwardDemodulation::getGreaterConstraint");
+
+  unsigned side = lhs==*eq->nthArgument(0) ? 0 : 1;
+  Ordering::GreaterConstraint** pres;
+  if(_greaterConstraints[side].getValuePtr(eq, pres)) {
+    *pres = _salg->getOrdering().compileGreaterConstraint(lhs, EqHelper::getOtherEqualitySide(eq, lhs));
+    env.sharing->pin(eq);
+  }
+  return *pres;
+}
+
+/**
+ * Instances of the variables of a demodulator given by the substitution
+ * of a query result
+ */
+class ResultVarMapping
+: public Ordering::VarMapping
+{
+public:
+  ResultVarMapping(ResultSubstitution* subst) : _subst(subst) {}
+  TermList apply(unsigned var) override
+  {
+    return _subst->applyToBoundResult(TermList(var, false));
+  }
+private:
+  ResultSubstitution* _subst;
+};
+
 
 bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterator& premises)
 {
@@ -128,7 +177,41 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	  continue;
 	}
 
+	Ordering::Result argOrder = ordering.getEqualityArgumentOrder(qr.literal);
+	bool preordered = argOrder==Ordering::LESS || argOrder==Ordering::GREATER;
+	if(!preordered && _preorderedOnly) {
+	  continue;
+	}
+
 	TermList rhs=EqHelper::getOtherEqualitySide(qr.literal,qr.term);
+#if VDEBUG
+	if(preordered) {
+	  if(argOrder==Ordering::LESS) {
+	    ASS_EQ(rhs, *qr.literal->nthArgument(0));
+	  }
+	  else {
+	    ASS_EQ(rhs, *qr.literal->nthArgument(1));
+	  }
+	}
+#endif
+
+	//the ordering test of unorientable equations is evaluated on the
+	//substitution when possible, so that rhsS is built only for
+	//demodulators that apply
+	bool orderChecked=preordered;
+	if(!preordered && qr.substitution->isIdentityOnQueryWhenResultBound()) {
+	  Ordering::GreaterConstraint* gc=getGreaterConstraint(qr.literal, qr.term);
+	  if(gc) {
+	    ResultVarMapping varMap(qr.substitution.ptr());
+	    bool greater=gc->holds(varMap);
+	    ASS_EQ(greater, ordering.compare(trm,qr.substitution->applyToBoundResult(rhs))==Ordering::GREATER);
+	    if(!greater) {
+	      continue;
+	    }
+	    orderChecked=true;
+	  }
+	}
+
 	TermList rhsS;
 	if(!qr.substitution->isIdentityOnQueryWhenResultBound()) {
 	  //When we apply substitution to the rhs, we get a term, that is
@@ -146,19 +229,7 @@ bool ForwardDemodulation::perform(Clause* cl, Clause*& replacement, ClauseIterat
 	  rhsS=qr.substitution->applyToBoundResult(rhs);
 	}
 
-	Ordering::Result argOrder = ordering.getEqualityArgumentOrder(qr.literal);
-	bool preordered = argOrder==Ordering::LESS || argOrder==Ordering::GREATER;
-#if VDEBUG
-	if(preordered) {
-	  if(argOrder==Ordering::LESS) {
-	    ASS_EQ(rhs, *qr.literal->nthArgument(0));
-	  }
-	  else {
-	    ASS_EQ(rhs, *qr.literal->nthArgument(1));
-	  }
-	}
-#endif
-	if(!preordered && (_preorderedOnly || ordering.compare(trm,rhsS)!=Ordering::GREATER) ) {
+	if(!orderChecked && ordering.compare(trm,rhsS)!=Ordering::GREATER) {
 	  continue;
 	}
 
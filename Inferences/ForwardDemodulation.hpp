@@ -26,6 +26,11 @@
 #define __ForwardDemodulation__
 
 #include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+
+#include "Kernel/Ordering.hpp"
+
 #include "Indexing/TermIndex.hpp"
 
 #include "InferenceEngine.hpp"
@@ -48,8 +53,18 @@ public:
   void detach() override;
   bool perform(Clause* cl, Clause*& replacement, ClauseIterator& premises) override;
 private:
+  Ordering::GreaterConstraint* getGreaterConstraint(Literal* eq, TermList lhs);
+  void destroyGreaterConstraints();
+
   bool _preorderedOnly;
   DemodulationLHSIndex* _index;
+
+  /**
+   * Precompiled ordering tests of equations that are not preordered,
+   * one map for each equation argument used as the lhs. A zero value
+   * means the ordering has no precompiled test.
+   */
+  DHMap<Literal*, Ordering::GreaterConstraint*> _greaterConstraints[2];
 };
 
 };
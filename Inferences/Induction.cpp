@@ -48,6 +48,7 @@
 
 #include "Indexing/Index.hpp"
 #include "Indexing/ResultSubstitution.hpp"
+#include "Indexing/TermSharing.hpp"
 #include "Inferences/BinaryResolution.hpp"
 
 #include "Induction.hpp"
@@ -659,6 +660,7 @@ bool InductionClauseIterator::notDone(Literal* lit, Term* term)
     unsigned fresh = env.signature->addFreshFunction(0,"blank");
     env.signature->getFunction(fresh)->setType(OperatorType::getConstantsType(srt));
     TermList blank = TermList(Term::createConstant(fresh));
+    env.sharing->pin(blank.term());
     blanks.insert(srt,blank);
   }
 
@@ -670,6 +672,7 @@ bool InductionClauseIterator::notDone(Literal* lit, Term* term)
   }
 
   done.insert(rep);
+  env.sharing->pin(rep);
 
   return true;
 }
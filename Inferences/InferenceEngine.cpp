@@ -24,6 +24,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Random.hpp"
 #include "Lib/DArray.hpp"
+#include "Lib/Int.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Metaiterators.hpp"
 
@@ -191,6 +192,41 @@ void CompositeGIE::detach()
   GeneratingInferenceEngine::detach();
 }
 
+ClauseRecipe::ClauseRecipe(Clause* premise1, Clause* premise2, unsigned weight)
+: _premise1(premise1), _premise2(premise2),
+  _age(Int::max(premise1->age(),premise2->age())+1), _weight(weight),
+  _inputType(Int::max(premise1->inputType(),premise2->inputType()))
+{
+  _premise1->incRefCnt();
+  _premise2->incRefCnt();
+  env.statistics->deferredInferences++;
+}
+
+ClauseRecipe::~ClauseRecipe()
+{
+  _premise1->decRefCnt();
+  _premise2->decRefCnt();
+}
+
+/**
+ * True if the conclusion will be a goal clause, which is determined,
+ * as for any clause, by its input type
+ */
+bool ClauseRecipe::isGoal() const
+{
+  return _inputType > Unit::ASSUMPTION;
+}
+
+/**
+ * Return true if both premises are still active. Otherwise one of
+ * them was simplified or removed by backtracking and the inference
+ * is redundant or will be performed again with the premise.
+ */
+bool ClauseRecipe::premisesActive() const
+{
+  return _premise1->store()==Clause::ACTIVE && _premise2->store()==Clause::ACTIVE;
+}
+
 
 Clause* DuplicateLiteralRemovalISE::simplify(Clause* c)
 {
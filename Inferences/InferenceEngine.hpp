@@ -105,6 +105,42 @@ public:
   virtual ClauseIterator generateClauses(Clause* premise) = 0;
 };
 
+/**
+ * Record of a generating inference kept instead of its conclusion
+ * until the conclusion is selected from passive (see the lazy_generation
+ * option). The recipe keeps its two premises referenced, and the keys
+ * of passive clause selection, where the weight is an estimate computed
+ * without building the conclusion.
+ */
+class ClauseRecipe
+{
+public:
+  CLASS_NAME(ClauseRecipe);
+  USE_ALLOCATOR(ClauseRecipe);
+
+  ClauseRecipe(Clause* premise1, Clause* premise2, unsigned weight);
+  virtual ~ClauseRecipe();
+
+  unsigned age() const { return _age; }
+  unsigned weight() const { return _weight; }
+  unsigned inputType() const { return _inputType; }
+  bool isGoal() const;
+
+  bool premisesActive() const;
+
+  /**
+   * Build the conclusion of the inference, or return zero if the
+   * inference turns out not to be applicable. Premises must be active.
+   */
+  virtual Clause* materialise() = 0;
+protected:
+  Clause* _premise1;
+  Clause* _premise2;
+  unsigned _age;
+  unsigned _weight;
+  unsigned _inputType;
+};
+
 class ImmediateSimplificationEngine
 : public InferenceEngine
 {
@@ -34,6 +34,7 @@
 #include "Kernel/EqHelper.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/Ordering.hpp"
+#include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
@@ -71,6 +72,9 @@ void Superposition::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(SUPERPOSITION_SUBTERM_SUBST_TREE) );
   _lhsIndex=static_cast<SuperpositionLHSIndex*> (
 	  _salg->getIndexManager()->request(SUPERPOSITION_LHS_SUBST_TREE) );
+  //recipes cannot recompute unifications with abstraction
+  _lazy = _salg->lazyGeneration() &&
+      env.options->unificationWithAbstraction()==Options::UnificationWithAbstraction::OFF;
 }
 
 void Superposition::detach()
@@ -149,6 +153,10 @@ struct Superposition::ForwardResultFn
     CALL("Superposition::ForwardResultFn::operator()");
 
     TermQueryResult& qr = arg.second;
+    if(_parent._lazy) {
+      return _parent.deferSuperposition(_cl, arg.first.first, arg.first.second,
+	    qr.clause, qr.literal, qr.term, qr.substitution, true, _limits);
+    }
     return _parent.performSuperposition(_cl, arg.first.first, arg.first.second,
 	    qr.clause, qr.literal, qr.term, qr.substitution, true, _limits, qr.constraints);
   }
@@ -172,6 +180,10 @@ struct Superposition::BackwardResultFn
     }
 
     TermQueryResult& qr = arg.second;
+    if(_parent._lazy) {
+      return _parent.deferSuperposition(qr.clause, qr.literal, qr.term,
+	    _cl, arg.first.first, arg.first.second, qr.substitution, false, _limits);
+    }
     return _parent.performSuperposition(qr.clause, qr.literal, qr.term,
 	    _cl, arg.first.first, arg.first.second, qr.substitution, false, _limits, qr.constraints);
   }
@@ -181,6 +193,44 @@ private:
   Superposition& _parent;
 };
 
+/**
+ * Superposition whose conclusion is built only when the recipe is
+ * selected from the passive container. The unifier is not kept, it is
+ * computed again from the rewritten term and the rewriting side.
+ */
+class Superposition::Recipe
+: public ClauseRecipe
+{
+public:
+  CLASS_NAME(Superposition::Recipe);
+  USE_ALLOCATOR(Superposition::Recipe);
+
+  Recipe(Superposition& parent, Clause* rwClause, Literal* rwLit, TermList rwTerm,
+      Clause* eqClause, Literal* eqLit, TermList eqLHS, bool eqIsResult, unsigned weight)
+  : ClauseRecipe(rwClause, eqClause, weight), _parent(parent),
+    _rwLit(rwLit), _rwTerm(rwTerm), _eqLit(eqLit), _eqLHS(eqLHS), _eqIsResult(eqIsResult) {}
+
+  Clause* materialise()
+  {
+    CALL("Superposition::Recipe::materialise");
+    ASS(premisesActive());
+
+    //the equality side is in the result bank iff it was retrieved from the index
+    int eqBank = _eqIsResult ? 1 : 0;
+    RobSubstitution subst;
+    ALWAYS(subst.unify(_eqLHS, eqBank, _rwTerm, 1-eqBank));
+    return _parent.performSuperposition(_premise1, _rwLit, _rwTerm, _premise2, _eqLit, _eqLHS,
+	ResultSubstitution::fromSubstitution(&subst, 0, 1), _eqIsResult,
+	_parent._salg->getLimits(), UnificationConstraintStackSP());
+  }
+private:
+  Superposition& _parent;
+  Literal* _rwLit;
+  TermList _rwTerm;
+  Literal* _eqLit;
+  TermList _eqLHS;
+  bool _eqIsResult;
+};
 
 ClauseIterator Superposition::generateClauses(Clause* premise)
 {
@@ -394,6 +444,66 @@ bool Superposition::earlyWeightLimitCheck(Clause* eqClause, Literal* eqLit,
   return true;
 }
 
+/**
+ * Perform the checks of performSuperposition() that do not need the
+ * substituted literals and, if they pass, pass a recipe of the inference
+ * to the saturation algorithm instead of building the conclusion.
+ * The weight of the recipe is computed from the weights of the substituted
+ * literals, without building them. Return 0.
+ */
+Clause* Superposition::deferSuperposition(
+    Clause* rwClause, Literal* rwLit, TermList rwTerm,
+    Clause* eqClause, Literal* eqLit, TermList eqLHS,
+    ResultSubstitutionSP subst, bool eqIsResult, Limits* limits)
+{
+  CALL("Superposition::deferSuperposition");
+
+  if(SortHelper::getTermSort(rwTerm, rwLit)!=SortHelper::getEqualityArgumentSort(eqLit)) {
+    return 0;
+  }
+  if(eqLHS.isVar() && !checkSuperpositionFromVariable(eqClause, eqLit, eqLHS)) {
+    return 0;
+  }
+  if(!checkClauseColorCompatibility(eqClause, rwClause)) {
+    return 0;
+  }
+
+  TermList tgtTerm = EqHelper::getOtherEqualitySide(eqLit, eqLHS);
+
+  int weightLimit = getWeightLimit(eqClause, rwClause, limits);
+  if(weightLimit!=-1) {
+    if(!earlyWeightLimitCheck(eqClause, eqLit, rwClause, rwLit, rwTerm, eqLHS, tgtTerm, subst, eqIsResult, weightLimit)) {
+      return 0;
+    }
+  }
+
+  int weight = subst->getApplicationWeight(rwLit, !eqIsResult);
+  int rwrBalance = subst->getApplicationWeight(tgtTerm, eqIsResult)-subst->getApplicationWeight(eqLHS, eqIsResult);
+  if(rwrBalance!=0) {
+    //at least one occurrence is rewritten, the substitution can create more
+    int rwrCnt = static_cast<int>(getSubtermOccurrenceCount(rwLit, rwTerm));
+    weight += rwrBalance*Int::max(rwrCnt, 1);
+  }
+  unsigned rwLength = rwClause->length();
+  for(unsigned i=0;i<rwLength;i++) {
+    Literal* curr=(*rwClause)[i];
+    if(curr!=rwLit) {
+      weight += subst->getApplicationWeight(curr, !eqIsResult);
+    }
+  }
+  unsigned eqLength = eqClause->length();
+  for(unsigned i=0;i<eqLength;i++) {
+    Literal* curr=(*eqClause)[i];
+    if(curr!=eqLit) {
+      weight += subst->getApplicationWeight(curr, eqIsResult);
+    }
+  }
+
+  _salg->addNewRecipe(new Recipe(*this, rwClause, rwLit, rwTerm, eqClause, eqLit, eqLHS,
+      eqIsResult, Int::max(weight, 1)));
+  return 0;
+}
+
 size_t Superposition::getSubtermOccurrenceCount(Term* trm, TermList subterm)
 {
   CALL("Superposition::getSubtermOccurrenceCount");
@@ -55,6 +55,10 @@ private:
 	  Clause* eqClause, Literal* eqLiteral, TermList eqLHS,
 	  ResultSubstitutionSP subst, bool eqIsResult, Limits* limits,
           UnificationConstraintStackSP constraints);
+  Clause* deferSuperposition(
+	  Clause* rwClause, Literal* rwLiteral, TermList rwTerm,
+	  Clause* eqClause, Literal* eqLiteral, TermList eqLHS,
+	  ResultSubstitutionSP subst, bool eqIsResult, Limits* limits);
 
   bool checkClauseColorCompatibility(Clause* eqClause, Clause* rwClause);
   static int getWeightLimit(Clause* eqClause, Clause* rwClause, Limits* limits);
@@ -74,8 +78,12 @@ private:
   struct RewritableResultsFn;
   struct BackwardResultFn;
 
+  class Recipe;
+
   SuperpositionSubtermIndex* _subtermIndex;
   SuperpositionLHSIndex* _lhsIndex;
+  /** conclusions are deferred as recipes (see the lazy_generation option) */
+  bool _lazy;
 };
 
 
@@ -34,6 +34,7 @@
 #include "Kernel/Clause.hpp"
 #include "Kernel/Unit.hpp"
 #include "Kernel/Inference.hpp"
+#include "Kernel/Renaming.hpp"
 #include "Kernel/Signature.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/Substitution.hpp"
@@ -42,6 +43,8 @@
 #include "Kernel/Sorts.hpp"
 #include "Kernel/Theory.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Saturation/SaturationAlgorithm.hpp"
 #include "Saturation/Splitter.hpp"
 
@@ -614,9 +617,75 @@ Term* getFreshConstant(unsigned index, unsigned srt)
   return (*sortedConstants)[index];
 }
 
+/**
+ * Return the solution of the SMT solver for @b theoryLiterals, or none
+ * if the solver gave none.
+ *
+ * The same sets of theory literals modulo variable renaming recur across
+ * clauses, so the solutions are cached for the literals with variables
+ * normalized in the order of their occurrence.
+ */
 VirtualIterator<Solution> TheoryInstAndSimp::getSolutions(Stack<Literal*>& theoryLiterals, bool guarded){
   CALL("TheoryInstAndSimp::getSolutions");
 
+  Renaming normalizer;
+  static Stack<Literal*> normalized;
+  normalized.reset();
+  Stack<Literal*>::BottomFirstIterator it(theoryLiterals);
+  while(it.hasNext()){
+    Literal* lit = it.next();
+    normalizer.normalizeVariables(lit);
+    normalized.push(normalizer.apply(lit));
+  }
+
+  CachedSolution* cached;
+  if(_solutionCache[guarded].getValuePtr(normalized,cached)){
+    Stack<Literal*>::Iterator nit(normalized);
+    while(nit.hasNext()){
+      env.sharing->pin(nit.next());
+    }
+    auto solutions = getSolutionsFromSolver(normalized,guarded);
+    if(solutions.hasNext()){
+      Solution sol = solutions.next();
+      cached->found = true;
+      cached->status = sol.status;
+      if(sol.status){
+        // the normalized variables are 0,1,...
+        unsigned varCnt = countIteratorElements(normalizer.items());
+        for(unsigned v=0;v<varCnt;v++){
+          TermList t;
+          cached->values.push(sol.subst.findBinding(v,t) ? t.term() : 0);
+          if(cached->values.top()){
+            env.sharing->pin(cached->values.top());
+          }
+        }
+      }
+    }
+  }
+  else{
+    env.statistics->theoryInstSimpCacheHits++;
+  }
+
+  if(!cached->found){
+    return VirtualIterator<Solution>::getEmpty();
+  }
+  Solution sol = Solution(cached->status);
+  if(cached->status){
+    VirtualIterator<Renaming::Item> vit = normalizer.items();
+    while(vit.hasNext()){
+      Renaming::Item item = vit.next();
+      Term* t = cached->values[item.second];
+      if(t){
+        sol.subst.bind(item.first,t);
+      }
+    }
+  }
+  return pvi(getSingletonIterator(sol));
+}
+
+VirtualIterator<Solution> TheoryInstAndSimp::getSolutionsFromSolver(Stack<Literal*>& theoryLiterals, bool guarded){
+  CALL("TheoryInstAndSimp::getSolutionsFromSolver");
+
   BYPASSING_ALLOCATOR;
 
   // Currently we just get the single solution from Z3
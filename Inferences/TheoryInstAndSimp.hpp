@@ -29,6 +29,8 @@
 
 #include "Forwards.hpp"
 #include "InferenceEngine.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
 #include "Kernel/Substitution.hpp"
 
 namespace Inferences
@@ -64,6 +66,22 @@ public:
 
 private:
 
+  /**
+   * A result of the SMT solver for a set of theory literals with normalized
+   * variables. The value of variable i is values[i], or zero if the solver
+   * gave none.
+   */
+  struct CachedSolution
+  {
+    CachedSolution() : found(false), status(false) {}
+    /** false if the solver gave no solution */
+    bool found;
+    bool status;
+    Stack<Term*> values;
+  };
+
+  VirtualIterator<Solution> getSolutionsFromSolver(Stack<Literal*>& theoryLiterals, bool guarded);
+
   void selectTheoryLiterals(Clause* cl, Stack<Literal*>& theoryLits);
 
   void originalSelectTheoryLiterals(Clause* cl, Stack<Literal*>& theoryLits,bool forZ3);
@@ -101,6 +119,12 @@ private:
   bool literalContainsVar(const Literal* lit, unsigned v);
 
   Splitter* _splitter;
+  /**
+   * Solutions for the sets of normalized theory literals that were
+   * solved before, the first for unguarded and the second for guarded
+   * calls to getSolutions()
+   */
+  DHMap<Stack<Literal*>,CachedSolution> _solutionCache[2];
   //SAT2F0 _naming;
   //Z3Interfacing* _solver;
 
@@ -80,6 +80,7 @@ Clause::Clause(unsigned length,InputType it,Inference* inf)
     _weight(0),
     _store(NONE),
     _in_active(0),
+    _dormant(false),
     _refCnt(0),
     _reductionTimestamp(0),
     _literalPositions(0),
@@ -153,6 +154,9 @@ void Clause::operator delete(void* ptr,unsigned length)
 
 void Clause::destroyExceptInferenceObject()
 {
+  if (_liveUnits) {
+    forgetLive();
+  }
   if (_literalPositions) {
     delete _literalPositions;
   }
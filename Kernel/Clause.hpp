@@ -63,6 +63,9 @@ private:
   ~Clause() { ASSERTION_VIOLATION; }
   /** Should never be used, just that compiler requires it */
   void operator delete(void* ptr) { ASSERTION_VIOLATION; }
+
+  friend class CompressedClause;
+  friend class ProofLog;
 public:
   typedef ArrayishObjectIterator<Clause> Iterator;
 
@@ -274,6 +277,14 @@ public:
   void incNumActiveSplits() { _numActiveSplits++; }
   void decNumActiveSplits() { _numActiveSplits--; }
 
+  /**
+   * A dormant clause is kept in the active container and its indices
+   * even though it depends on a deactivated split level
+   * (see the avatar_lazy_deactivation option). Index retrieval skips it.
+   */
+  bool isDormant() const { return _dormant; }
+  void setDormant(bool d) { _dormant = d; }
+
   VirtualIterator<vstring> toSimpleClauseStrings();
 
 
@@ -378,6 +389,8 @@ protected:
   Store _store;
   /** in active index **/
   bool _in_active;
+  /** kept in active while depending on a deactivated split level */
+  bool _dormant;
   /** number of references to this clause */
   unsigned _refCnt;
   /** for splitting: timestamp marking when has the clause been reduced or restored by splitting */
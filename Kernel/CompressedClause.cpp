@@ -0,0 +1,247 @@
+
+/*
+ * File CompressedClause.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompressedClause.cpp
+ * Implements class CompressedClause.
+ */
+
+#include "Debug/RuntimeStatistics.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/SharedSet.hpp"
+
+#include "Clause.hpp"
+#include "Inference.hpp"
+#include "Signature.hpp"
+#include "SortHelper.hpp"
+#include "Term.hpp"
+
+#include "CompressedClause.hpp"
+
+namespace Kernel {
+
+/**
+ * Return the number of bytes of a compressed clause with
+ * @b codeSize code elements
+ */
+size_t CompressedClause::sizeFor(unsigned codeSize)
+{
+  //same as in Clause::operator new, (codeSize-1) would not behave well for zero
+  size_t size = sizeof(CompressedClause) + codeSize * sizeof(unsigned);
+  size -= sizeof(unsigned);
+  return size;
+}
+
+CompressedClause::CompressedClause(Clause* cl, unsigned codeSize)
+ : _inference(cl->inference()),
+   _number(cl->number()),
+   _age(cl->age()),
+   _length(cl->length()),
+   _inputType(cl->isTaggedExtensionality() ? Unit::EXTENSIONALITY_AXIOM : cl->inputType()),
+   _emptySplits(cl->splits()!=0),
+   _codeSize(codeSize)
+{
+}
+
+/**
+ * Return true if @b cl can be replaced by a compressed clause,
+ * that is, nothing refers to it besides the container holding it
+ * and it carries no state that would not be restored.
+ */
+bool CompressedClause::canCompress(Clause* cl)
+{
+  CALL("CompressedClause::canCompress");
+
+  return cl->_refCnt==0 && cl->noSplits() && !cl->isInput() &&
+      !cl->isFromPreprocessing() && !cl->numSelected() && !env.colorUsed;
+}
+
+/**
+ * Append the code of @b t to @b code. Return false if @b t
+ * contains a special term, which cannot be encoded.
+ */
+bool CompressedClause::encode(TermList t, Stack<unsigned>& code)
+{
+  CALL("CompressedClause::encode");
+
+  if(t.isVar()) {
+    code.push(2*t.var()+1);
+    return true;
+  }
+  Term* trm=t.term();
+  if(trm->isSpecial()) {
+    return false;
+  }
+  code.push(2*trm->functor());
+  for(TermList* arg=trm->args(); arg->isNonEmpty(); arg=arg->next()) {
+    if(!encode(*arg, code)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Append the code of @b lit to @b code. Return false if @b lit
+ * contains a special term, which cannot be encoded.
+ */
+bool CompressedClause::encodeLiteral(Literal* lit, Stack<unsigned>& code)
+{
+  CALL("CompressedClause::encodeLiteral");
+
+  code.push(2*lit->functor()+(lit->polarity() ? 1 : 0));
+  if(lit->isEquality()) {
+    code.push(SortHelper::getEqualityArgumentSort(lit));
+  }
+  for(TermList* arg=lit->args(); arg->isNonEmpty(); arg=arg->next()) {
+    if(!encode(*arg, code)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Replace @b cl by a compressed clause and destroy the Clause
+ * object, or return zero if @b cl cannot be encoded.
+ *
+ * @b cl must satisfy canCompress().
+ */
+CompressedClause* CompressedClause::compress(Clause* cl)
+{
+  CALL("CompressedClause::compress");
+  ASS(canCompress(cl));
+
+  static Stack<unsigned> code;
+  code.reset();
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    if(!encodeLiteral((*cl)[i], code)) {
+      return 0;
+    }
+  }
+
+  void* mem=ALLOC_KNOWN(sizeFor(code.size()), "CompressedClause");
+  CompressedClause* res=new(mem) CompressedClause(cl, code.size());
+  for(unsigned i=0;i<code.size();i++) {
+    res->_code[i]=code[i];
+  }
+
+  //the inference object now belongs to res
+  cl->destroyExceptInferenceObject();
+  RSTAT_CTR_INC("clauses compressed");
+  return res;
+}
+
+TermList CompressedClause::decodeTerm(const unsigned*& code)
+{
+  CALL("CompressedClause::decodeTerm");
+
+  unsigned c=*(code++);
+  if(c&1) {
+    return TermList(c/2, false);
+  }
+  unsigned functor=c/2;
+  unsigned arity=env.signature->functionArity(functor);
+  if(!arity) {
+    return TermList(Term::createConstant(functor));
+  }
+
+  static Stack<TermList> args;
+  size_t start=args.size();
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg=decodeTerm(code);
+    args.push(arg);
+  }
+  Term* res=Term::create(functor, arity, args.begin()+start);
+  args.truncate(start);
+  return TermList(res);
+}
+
+Literal* CompressedClause::decodeLiteral(const unsigned*& code)
+{
+  CALL("CompressedClause::decodeLiteral");
+
+  unsigned header=*(code++);
+  unsigned pred=header/2;
+  bool polarity=header&1;
+  if(pred==0) {
+    unsigned sort=*(code++);
+    TermList lhs=decodeTerm(code);
+    TermList rhs=decodeTerm(code);
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+
+  unsigned arity=env.signature->predicateArity(pred);
+  static Stack<TermList> args;
+  args.reset();
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg=decodeTerm(code);
+    args.push(arg);
+  }
+  return Literal::create(pred, arity, polarity, false, args.begin());
+}
+
+/**
+ * Rebuild the clause and destroy this object. The clause gets
+ * the number, age and inference of the original one.
+ */
+Clause* CompressedClause::decompress()
+{
+  CALL("CompressedClause::decompress");
+
+  static Stack<Literal*> lits;
+  lits.reset();
+  const unsigned* code=_code;
+  for(unsigned i=0;i<_length;i++) {
+    lits.push(decodeLiteral(code));
+  }
+  ASS_EQ(code, _code+_codeSize);
+
+  Clause* cl=Clause::fromStack(lits, static_cast<Unit::InputType>(_inputType), _inference);
+  cl->_number=_number;
+  cl->setAge(_age);
+  if(_emptySplits) {
+    cl->setSplits(SplitSet::getEmpty());
+  }
+
+  DEALLOC_KNOWN(this, sizeFor(_codeSize), "CompressedClause");
+  return cl;
+}
+
+/**
+ * Destroy the compressed clause without rebuilding it, releasing
+ * the premises of its inference
+ */
+void CompressedClause::destroy()
+{
+  CALL("CompressedClause::destroy");
+
+  Inference::Iterator it=_inference->iterator();
+  while(_inference->hasNext(it)) {
+    Unit* premise=_inference->next(it);
+    premise->decRefCnt();
+  }
+  delete _inference;
+
+  DEALLOC_KNOWN(this, sizeFor(_codeSize), "CompressedClause");
+}
+
+}
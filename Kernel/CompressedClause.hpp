@@ -0,0 +1,99 @@
+
+/*
+ * File CompressedClause.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompressedClause.hpp
+ * Defines class CompressedClause.
+ */
+
+#ifndef __CompressedClause__
+#define __CompressedClause__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Unit.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * A clause stored as a flat sequence of symbol codes instead of
+ * a Clause object with shared literals.
+ *
+ * Each literal is stored as its header (predicate and polarity),
+ * followed by the argument sort for equalities, and its arguments
+ * in prefix order, a variable @b v as 2v+1 and a function symbol
+ * @b f as 2f. Arities are taken from the signature.
+ *
+ * The compressed clause takes over the inference object of the
+ * clause, so that its premises stay referenced, and restores the
+ * number, age and input type of the clause when it is rebuilt.
+ */
+class CompressedClause
+{
+public:
+  static bool canCompress(Clause* cl);
+  static CompressedClause* compress(Clause* cl);
+
+  Clause* decompress();
+  void destroy();
+
+  unsigned length() const { return _length; }
+  unsigned number() const { return _number; }
+  unsigned age() const { return _age; }
+  Unit::InputType inputType() const { return static_cast<Unit::InputType>(_inputType); }
+
+  /** The codes of the literals, see encodeLiteral() */
+  const unsigned* code() const { return _code; }
+  unsigned codeSize() const { return _codeSize; }
+
+  static bool encodeLiteral(Literal* lit, Stack<unsigned>& code);
+  static Literal* decodeLiteral(const unsigned*& code);
+  static bool encode(TermList t, Stack<unsigned>& code);
+  static TermList decodeTerm(const unsigned*& code);
+
+private:
+  CompressedClause(Clause* cl, unsigned codeSize);
+
+  static size_t sizeFor(unsigned codeSize);
+
+  /** Inference of the original clause */
+  Inference* _inference;
+  /** Number of the original clause */
+  unsigned _number;
+  /** Age of the original clause */
+  unsigned _age;
+  /** Number of literals */
+  unsigned _length : 20;
+  /** Input type passed to the Clause constructor */
+  unsigned _inputType : 4;
+  /** The original clause had an empty split set rather than none */
+  unsigned _emptySplits : 1;
+  /** Number of elements of _code */
+  unsigned _codeSize;
+  /** The literal codes, allocated together with the object */
+  unsigned _code[1];
+};
+
+}
+
+#endif // __CompressedClause__
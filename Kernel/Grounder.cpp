@@ -26,6 +26,8 @@
 #include "Lib/Environment.hpp"
 #include "Lib/SharedSet.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Kernel/Clause.hpp"
 #include "Kernel/InferenceStore.hpp"
 #include "Kernel/Renaming.hpp"
@@ -168,6 +170,7 @@ SATLiteral Grounder::groundNormalized(Literal* lit)
   unsigned* pvar;
   if(_asgn.getValuePtr(posLit, pvar)) {    
     *pvar = _satSolver->newVar();
+    env.sharing->pin(posLit);
   }
   return SATLiteral(*pvar, isPos);
 }
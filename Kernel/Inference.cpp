@@ -447,6 +447,8 @@ vstring Inference::ruleName(Rule rule)
     return "term algebras acyclicity";
   case EXTERNAL:
     return "external";
+  case CHECKPOINT:
+    return "checkpoint";
   case CLAIM_DEFINITION:
     return "claim definition";
   case BFNT_FLATTENING:
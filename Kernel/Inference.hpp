@@ -289,6 +289,8 @@ public:
     DISTINCT_EQUALITY_REMOVAL,
     /** inference coming from outside of Vampire */
     EXTERNAL,
+    /** clause saved by an earlier run in a checkpoint (see the resume_file option) */
+    CHECKPOINT,
     /** claim definition, definition introduced by a claim in the input */
     CLAIM_DEFINITION,
     /** BNFT flattening */
@@ -342,10 +344,17 @@ public:
    * minimizing call to after
    * a complete refutation has been found.
    *
-   * This is meant to be a no-op for all inferences except those related to SAT.
+   * This is meant to be a no-op for all inferences except those related to SAT
+   * and LoggedInference, which rebuilds its premises from the proof log.
    */
   virtual void minimizePremises() {}
 
+  /**
+   * True if the inference can be replaced by a LoggedInference, see ProofLog.
+   * Not the case if the premises are yet to be minimized.
+   */
+  virtual bool loggable() const { return true; }
+
   static vstring ruleName(Rule rule);
   vstring name() const { return ruleName(_rule); }
 
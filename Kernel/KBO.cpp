@@ -28,10 +28,17 @@
 
 #include "Lib/Environment.hpp"
 #include "Lib/Comparison.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Indexing/TermSharing.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
+#include "SubstHelper.hpp"
 #include "Term.hpp"
+#include "TermIterators.hpp"
 #include "KBO.hpp"
 #include "Signature.hpp"
 
@@ -296,7 +303,7 @@ void KBO::State::traverse(Term* t1, Term* t2)
  * Create a KBO object.
  */
 KBO::KBO(Problem& prb, const Options& opt)
- : PrecedenceOrdering(prb, opt)
+ : PrecedenceOrdering(prb, opt), _cacheCollections(0)
 {
   CALL("KBO::KBO");
 
@@ -304,6 +311,14 @@ KBO::KBO(Problem& prb, const Options& opt)
   _defaultSymbolWeight = 1;
 
   _state=new State(this);
+
+  if(opt.kboCacheSize()) {
+    size_t cacheSize=1;
+    while(cacheSize<opt.kboCacheSize()) {
+      cacheSize<<=1;
+    }
+    _cache.ensure(cacheSize);
+  }
 }
 
 KBO::~KBO()
@@ -388,6 +403,25 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
+  CacheEntry* ce=0;
+  if(_cache.size() && t1->shared() && t2->shared()) {
+    if(_cacheCollections!=env.sharing->collections()) {
+      //the terms of some entries may have been destroyed
+      _cache.init(_cache.size(), CacheEntry());
+      _cacheCollections=env.sharing->collections();
+    }
+    ce=&getCacheEntry(t1,t2);
+    if(ce->t1==t1 && ce->t2==t2) {
+      env.statistics->kboCacheHits++;
+      return ce->res;
+    }
+    if(ce->t1==t2 && ce->t2==t1) {
+      env.statistics->kboCacheHits++;
+      return reverse(ce->res);
+    }
+    env.statistics->kboCacheMisses++;
+  }
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -406,9 +440,274 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
 #if VDEBUG
   _state=state;
 #endif
+  if(ce) {
+    ce->t1=t1;
+    ce->t2=t2;
+    ce->res=res;
+  }
+  return res;
+}
+
+/**
+ * Return the cache entry for the pair @b t1, @b t2. Both orders of
+ * the pair are mapped to the same entry.
+ */
+KBO::CacheEntry& KBO::getCacheEntry(Term* t1, Term* t2) const
+{
+  size_t a = reinterpret_cast<size_t>(t1) >> 3;
+  size_t b = reinterpret_cast<size_t>(t2) >> 3;
+  size_t h = (a ^ b) * 2654435761u + (a + b);
+  h ^= h >> 15;
+  return _cache[h & (_cache.size()-1)];
+}
+
+/**
+ * KBO comparison of the instances of two terms, compiled into a linear
+ * test on the weights of the variable instances, the variable condition,
+ * and a chain of tests for the case of equal weights. Symbol precedence
+ * and the comparisons of non-instantiated argument pairs are decided
+ * when the constraint is built, so that only the parts depending on the
+ * instances are evaluated at each use.
+ *
+ * All symbols must have unit weight, so that the weight of a shared
+ * instance is given by Term::weight().
+ */
+class KBO::KBOGreaterConstraint
+: public Ordering::GreaterConstraint
+{
+public:
+  CLASS_NAME(KBO::KBOGreaterConstraint);
+  USE_ALLOCATOR(KBOGreaterConstraint);
+
+  KBOGreaterConstraint(const KBO& kbo, TermList lhs, TermList rhs);
+
+  bool holds(VarMapping& map) const override;
+private:
+  /** How the case of equal weights of the instances is decided */
+  enum TieBreak {
+    /** heads differ, the lhs head has greater precedence */
+    TIE_GREATER,
+    /** heads differ, the rhs head has greater precedence */
+    TIE_LESS,
+    /** heads are equal, decided by the argument tests in _argTests */
+    TIE_ARGUMENTS,
+    /** the rhs is a variable, the instances are compared in full */
+    TIE_COMPARE
+  };
+
+  /**
+   * Pair of arguments compared when the weights are equal. The result
+   * is GREATER or LESS if it does not depend on the instance, otherwise
+   * INCOMPARABLE and the instances of the arguments are compared.
+   */
+  struct ArgTest
+  {
+    ArgTest() {}
+    ArgTest(TermList lhs, TermList rhs, Result res) : lhs(lhs), rhs(rhs), res(res) {}
+    TermList lhs;
+    TermList rhs;
+    Result res;
+  };
+
+  void addWeights(TermList t, int coef, DHMap<unsigned,int>& varCoefs);
+  bool variableCondition() const;
+  static int instanceWeight(TermList t);
+
+  const KBO& _kbo;
+  TermList _lhs;
+  TermList _rhs;
+  /** Weight difference of the non-variable symbols */
+  int _weightDiff;
+  /** Variables with different numbers of occurrences and their
+   * occurrence difference */
+  Stack<pair<unsigned,int> > _varCoefs;
+  /** True if some variable occurs more times in the rhs */
+  bool _negativeVars;
+  TieBreak _tieBreak;
+  Stack<ArgTest> _argTests;
+
+  /** Instances of the variables in _varCoefs during evaluation */
+  static Stack<TermList> s_instances;
+};
+
+Stack<TermList> KBO::KBOGreaterConstraint::s_instances;
+
+KBO::KBOGreaterConstraint::KBOGreaterConstraint(const KBO& kbo, TermList lhs, TermList rhs)
+ : _kbo(kbo), _lhs(lhs), _rhs(rhs), _weightDiff(0), _negativeVars(false)
+{
+  CALL("KBO::KBOGreaterConstraint::KBOGreaterConstraint");
+  ASS(lhs.isTerm());
+
+  static DHMap<unsigned,int> varCoefs;
+  varCoefs.reset();
+  addWeights(lhs, 1, varCoefs);
+  addWeights(rhs, -1, varCoefs);
+
+  DHMap<unsigned,int>::Iterator vit(varCoefs);
+  while(vit.hasNext()) {
+    unsigned var;
+    int coef;
+    vit.next(var, coef);
+    if(coef) {
+      _varCoefs.push(make_pair(var, coef));
+      _negativeVars |= coef<0;
+    }
+  }
+
+  if(rhs.isVar()) {
+    _tieBreak=TIE_COMPARE;
+    return;
+  }
+  Term* l=lhs.term();
+  Term* r=rhs.term();
+  if(l->functor()!=r->functor()) {
+    _tieBreak=_kbo.compareFunctionPrecedences(l->functor(), r->functor())==GREATER ? TIE_GREATER : TIE_LESS;
+    return;
+  }
+  _tieBreak=TIE_ARGUMENTS;
+  for(unsigned i=0;i<l->arity();i++) {
+    TermList la=*l->nthArgument(i);
+    TermList ra=*r->nthArgument(i);
+    Result res=_kbo.compare(la, ra);
+    if(res==EQUAL) {
+      continue;
+    }
+    if(res==GREATER || res==LESS) {
+      //comparisons of the instances agree, the later arguments are never reached
+      _argTests.push(ArgTest(la, ra, res));
+      break;
+    }
+    _argTests.push(ArgTest(la, ra, INCOMPARABLE));
+  }
+}
+
+/**
+ * Add @b coef times the symbol weight of @b t to _weightDiff and
+ * @b coef times the number of occurrences of each variable to @b varCoefs
+ */
+void KBO::KBOGreaterConstraint::addWeights(TermList t, int coef, DHMap<unsigned,int>& varCoefs)
+{
+  CALL("KBO::KBOGreaterConstraint::addWeights");
+
+  int varOccurrences=0;
+  VariableIterator vit(t);
+  while(vit.hasNext()) {
+    int* pcoef;
+    varCoefs.getValuePtr(vit.next().var(), pcoef, 0);
+    (*pcoef)+=coef;
+    varOccurrences++;
+  }
+  if(t.isTerm()) {
+    _weightDiff+=coef*(instanceWeight(t)-varOccurrences);
+  }
+}
+
+/**
+ * Return the weight of @b t, which may be an unshared term
+ */
+int KBO::KBOGreaterConstraint::instanceWeight(TermList t)
+{
+  if(t.isVar()) {
+    return 1;
+  }
+  Term* trm=t.term();
+  if(trm->shared()) {
+    return trm->weight();
+  }
+  int res=1;
+  for(TermList* arg=trm->args(); !arg->isEmpty(); arg=arg->next()) {
+    res+=instanceWeight(*arg);
+  }
   return res;
 }
 
+/**
+ * Return true iff no variable occurs more times in the rhs instance
+ * than in the lhs instance, where s_instances holds the instances
+ * of the variables in _varCoefs
+ */
+bool KBO::KBOGreaterConstraint::variableCondition() const
+{
+  CALL("KBO::KBOGreaterConstraint::variableCondition");
+
+  static DHMap<unsigned,int> counts;
+  counts.reset();
+  for(unsigned i=0;i<_varCoefs.size();i++) {
+    int coef=_varCoefs[i].second;
+    VariableIterator vit(s_instances[i]);
+    while(vit.hasNext()) {
+      int* pcnt;
+      counts.getValuePtr(vit.next().var(), pcnt, 0);
+      (*pcnt)+=coef;
+    }
+  }
+  DHMap<unsigned,int>::Iterator cit(counts);
+  while(cit.hasNext()) {
+    if(cit.next()<0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool KBO::KBOGreaterConstraint::holds(VarMapping& map) const
+{
+  CALL("KBO::KBOGreaterConstraint::holds");
+
+  s_instances.reset();
+  int weightDiff=_weightDiff;
+  for(unsigned i=0;i<_varCoefs.size();i++) {
+    TermList inst=map.apply(_varCoefs[i].first);
+    s_instances.push(inst);
+    weightDiff+=_varCoefs[i].second*instanceWeight(inst);
+  }
+  if(weightDiff<0) {
+    return false;
+  }
+  if(_negativeVars && !variableCondition()) {
+    return false;
+  }
+  if(weightDiff>0) {
+    return true;
+  }
+
+  switch(_tieBreak) {
+  case TIE_GREATER:
+    return true;
+  case TIE_LESS:
+    return false;
+  case TIE_ARGUMENTS:
+    for(unsigned i=0;i<_argTests.size();i++) {
+      const ArgTest& test=_argTests[i];
+      if(test.res!=INCOMPARABLE) {
+        return test.res==GREATER;
+      }
+      TermList lhsS=SubstHelper::apply(test.lhs, map);
+      TermList rhsS=SubstHelper::apply(test.rhs, map);
+      if(lhsS!=rhsS) {
+        return _kbo.compare(lhsS, rhsS)==GREATER;
+      }
+    }
+    //the instances are equal
+    return false;
+  case TIE_COMPARE:
+    return _kbo.compare(SubstHelper::apply(_lhs, map), SubstHelper::apply(_rhs, map))==GREATER;
+  }
+  ASSERTION_VIOLATION;
+  return false;
+}
+
+Ordering::GreaterConstraint* KBO::compileGreaterConstraint(TermList lhs, TermList rhs) const
+{
+  CALL("KBO::compileGreaterConstraint");
+
+  if(env.colorUsed || lhs.isVar()) {
+    //colored symbols are heavier than Term::weight() assumes
+    return 0;
+  }
+  return new KBOGreaterConstraint(*this, lhs, rhs);
+}
+
 int KBO::functionSymbolWeight(unsigned fun) const
 {
   int weight = _defaultSymbolWeight;
@@ -52,10 +52,13 @@ public:
 
   using PrecedenceOrdering::compare;
   Result compare(TermList tl1, TermList tl2) const override;
+
+  GreaterConstraint* compileGreaterConstraint(TermList lhs, TermList rhs) const override;
 protected:
   Result comparePredicates(Literal* l1, Literal* l2) const override;
 
   class State;
+  class KBOGreaterConstraint;
   /** Weight of variables */
   int _variableWeight;
   /** Weight of function symbols not occurring in the
@@ -67,6 +70,25 @@ protected:
   bool allConstantsHeavierThanVariables() const { return false; }
   bool existsZeroWeightUnaryFunction() const { return false; }
 
+  /**
+   * Entry of the cache of comparison results. Shared terms are only
+   * destroyed by TermSharing::collect(), so a result stored for a pair
+   * of them stays valid until the next collection.
+   */
+  struct CacheEntry
+  {
+    CacheEntry() : t1(0), t2(0) {}
+    Term* t1;
+    Term* t2;
+    Result res;
+  };
+  CacheEntry& getCacheEntry(Term* t1, Term* t2) const;
+
+  /** Direct-mapped cache of comparisons of shared terms, empty if disabled.
+   * The size is a power of two. */
+  mutable DArray<CacheEntry> _cache;
+  /** The number of term collections when the cache was last emptied */
+  mutable unsigned _cacheCollections;
 
   /**
    * State used for comparing terms and literals
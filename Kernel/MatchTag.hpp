@@ -27,73 +27,80 @@
 
 #include "Forwards.hpp"
 
+#include "Debug/Assertion.hpp"
+
 #include "Lib/BitUtils.hpp"
 
-//Tests shown it as not helping. Perhaps needs just some improvement of bit selection.
-#define USE_MATCH_TAG 0
+/**
+ * If non-zero, shared terms carry a MatchTag that is used to reject
+ * matching and unification attempts before descending into the terms.
+ */
+#define USE_MATCH_TAG 1
 
 namespace Kernel {
 
 #if USE_MATCH_TAG
 
-
+/**
+ * A 32-bit summary of a shared term that is computed in TermSharing
+ * when the term is inserted.
+ *
+ * It consists of a bloom filter of the function symbols occurring
+ * in the term and of the depth of the term (saturated at MAX_DEPTH).
+ * Both are monotone w.r.t. instantiation, so if @b s is an instance
+ * of @b t, the symbols of @b t are a subset of the symbols of @b s and
+ * the depth of @b t is at most the depth of @b s.
+ *
+ * For literals the predicate symbol is not recorded, the header is
+ * compared separately.
+ */
 class MatchTag
 {
 public:
-  inline void makeEmpty() throw() {_content=EMPTY_CONTENT; }
+  static const unsigned SYMBOL_BITS=26;
+  static const unsigned DEPTH_BITS=6;
+  static const unsigned MAX_DEPTH=(1u<<DEPTH_BITS)-1;
 
-  inline bool isEmpty() {
-    return _content==EMPTY_CONTENT;
-  }
+  inline void makeEmpty() { _symbols=0; _depth=0; }
 
-  inline void ensureInit(Term* t)
+  /** Make this the tag of a term with top symbol @b functor and no arguments yet */
+  inline void initHead(unsigned functor, bool literal)
   {
-    if(isEmpty()) {
-      init(t);
-    }
+    _symbols = literal ? 0 : symbolBit(functor);
+    _depth = 1;
   }
 
-  inline bool couldBeInstanceOf(MatchTag base)
+  /** Extend this tag by an argument that is a shared term with tag @b arg */
+  inline void addArgument(MatchTag arg)
   {
-    if(base._content==EMPTY_CONTENT_REPLACEMENT) {
-      return BitUtils::isSubset(EMPTY_CONTENT, _content);
+    _symbols |= arg._symbols;
+    if(arg._depth>=_depth) {
+      _depth = (arg._depth==MAX_DEPTH) ? MAX_DEPTH : arg._depth+1;
     }
-    return BitUtils::isSubset(base._content, _content);
   }
-  inline bool couldBeInstanceOfReversed(MatchTag base)
+
+  /**
+   * Return false if a term with this tag certainly cannot be an instance
+   * of a term with the tag @b base
+   */
+  inline bool couldBeInstanceOf(MatchTag base) const
   {
-    if(base._content==EMPTY_CONTENT_REPLACEMENT) {
-      return BitUtils::isSubset(EMPTY_CONTENT, _highContent) &&
-        BitUtils::isSubset(base._highContent, _lowContent);
-    }
-    return BitUtils::isSubset(base._lowContent, _highContent) &&
-      BitUtils::isSubset(base._highContent, _lowContent);
+    return base._depth<=_depth && BitUtils::isSubset(_symbols, base._symbols);
   }
 
-
-  static const unsigned EMPTY_CONTENT=3;
-  static const unsigned EMPTY_CONTENT_REPLACEMENT=1;
-  static const unsigned CONTENT_BITS=sizeof(unsigned)*8;
-
 private:
-  void init(Term* t);
-
-  static unsigned getContent(Term* t);
+  inline static unsigned symbolBit(unsigned functor)
+  {
+    //symbols are numbered consecutively, so taking the remainder
+    //spreads small signatures evenly over the filter
+    return 1u<<(functor%SYMBOL_BITS);
+  }
 
-  union {
-    unsigned _content;
-    struct {
-      unsigned _lowContent : CONTENT_BITS/2;
-      unsigned _highContent : CONTENT_BITS/2;
-    };
-  };
+  unsigned _symbols : SYMBOL_BITS;
+  unsigned _depth : DEPTH_BITS;
 };
 
-//EMPTY_CONTENT_REPLACEMENT is subset of EMPTY_CONTENT
-ASS_STATIC( (MatchTag::EMPTY_CONTENT&MatchTag::EMPTY_CONTENT_REPLACEMENT)==MatchTag::EMPTY_CONTENT_REPLACEMENT );
-//EMPTY_CONTENT_REPLACEMENT has zeroes only in the lower half
-ASS_STATIC( MatchTag::EMPTY_CONTENT<0x10000 );
-
+ASS_STATIC(sizeof(MatchTag)==sizeof(unsigned));
 
 #endif
 
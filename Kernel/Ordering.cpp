@@ -230,6 +230,13 @@ Ordering::Result Ordering::getEqualityArgumentOrder(Literal* eq) const
   return res;
 }
 
+Ordering::GreaterConstraint* Ordering::compileGreaterConstraint(TermList lhs, TermList rhs) const
+{
+  CALL("Ordering::compileGreaterConstraint");
+
+  return 0;
+}
+
 //////////////////////////////////////////////////
 // PrecedenceOrdering class
 //////////////////////////////////////////////////
@@ -111,6 +111,40 @@ public:
   static Ordering* tryGetGlobalOrdering();
 
   Result getEqualityArgumentOrder(Literal* eq) const;
+
+  /**
+   * Mapping of the variables of an equation to their instances
+   */
+  class VarMapping
+  {
+  public:
+    virtual ~VarMapping() {}
+    virtual TermList apply(unsigned var) = 0;
+  };
+
+  /**
+   * Test of whether instances of one side of an equation are greater
+   * than the corresponding instances of the other side, compiled once
+   * for an equation the ordering does not orient.
+   */
+  class GreaterConstraint
+  {
+  public:
+    CLASS_NAME(Ordering::GreaterConstraint);
+    USE_ALLOCATOR(Ordering::GreaterConstraint);
+
+    virtual ~GreaterConstraint() {}
+    /** Return true iff the instance of lhs under @b map is greater
+     * than the instance of rhs */
+    virtual bool holds(VarMapping& map) const = 0;
+  };
+
+  /**
+   * Return a GreaterConstraint for @b lhs and @b rhs, or zero if the
+   * ordering has no precompiled form of the test. The caller owns
+   * the returned object.
+   */
+  virtual GreaterConstraint* compileGreaterConstraint(TermList lhs, TermList rhs) const;
 protected:
 
   Result compareEqualities(Literal* eq1, Literal* eq2) const;
@@ -0,0 +1,394 @@
+
+/*
+ * File ProofLog.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ProofLog.cpp
+ * Implements classes ProofLog and LoggedInference.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/TimeCounter.hpp"
+
+#include "Clause.hpp"
+#include "CompressedClause.hpp"
+
+#include "ProofLog.hpp"
+
+namespace Kernel {
+
+LoggedInference::LoggedInference(Rule rule, unsigned record, unsigned maxDepth)
+ : InferenceMany(rule, 0),
+   _record(record),
+   _rebuilt(false)
+{
+  _maxDepth=maxDepth;
+  ProofLog::instance()->_inferences.insert(this);
+}
+
+LoggedInference::~LoggedInference()
+{
+  ProofLog::instance()->_inferences.remove(this);
+}
+
+/**
+ * Rebuild the premises from the log
+ */
+void LoggedInference::minimizePremises()
+{
+  CALL("LoggedInference::minimizePremises");
+
+  if(_rebuilt) {
+    return;
+  }
+  _rebuilt=true;
+  _premises=ProofLog::instance()->premises(_record);
+}
+
+ProofLog* ProofLog::instance()
+{
+  static ScopedPtr<ProofLog> inst(new ProofLog());
+
+  return inst.ptr();
+}
+
+/**
+ * Allow compact() to log the derivations of the clauses created
+ * from now on
+ */
+void ProofLog::enable()
+{
+  CALL("ProofLog::enable");
+
+  _enabled=true;
+  Unit::trackLiveUnits();
+}
+
+/**
+ * True if the inference of @b cl can be replaced by a LoggedInference.
+ * The clauses from preprocessing are kept as they are, as InferenceStore
+ * may store information about them.
+ */
+bool ProofLog::canRecord(Clause* cl)
+{
+  CALL("ProofLog::canRecord");
+
+  return cl->inference()->loggable() && !cl->isFromPreprocessing() && !env.colorUsed;
+}
+
+/**
+ * Append a record of the derivation of @b cl to the log and replace
+ * the inference of @b cl by a LoggedInference, releasing the premises.
+ * Return false if the literals of @b cl cannot be encoded.
+ *
+ * The premises that can be recorded must have been recorded already.
+ */
+bool ProofLog::record(Clause* cl)
+{
+  CALL("ProofLog::record");
+  ASS(canRecord(cl));
+
+  unsigned codeStart=_code.size();
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    if(!CompressedClause::encodeLiteral((*cl)[i], _code)) {
+      _code.truncate(codeStart);
+      return false;
+    }
+  }
+
+  Inference* inf=cl->inference();
+  unsigned index=_records.size();
+  Record rec;
+  rec.clause=cl;
+  rec.number=cl->number();
+  rec.age=cl->age();
+  rec.rule=inf->rule();
+  rec.inputType=cl->isTaggedExtensionality() ? Unit::EXTENSIONALITY_AXIOM : cl->inputType();
+  rec.splits=cl->splits();
+  rec.codeStart=codeStart;
+  rec.premiseStart=_premises.size();
+  _records.push(rec);
+
+  Inference::Iterator it=inf->iterator();
+  while(inf->hasNext(it)) {
+    Unit* prem=inf->next(it);
+    Inference* premInf=prem->inference();
+    if(_inferences.contains(premInf)) {
+      _premises.push(2*static_cast<LoggedInference*>(premInf)->record());
+    }
+    else {
+      prem->incRefCnt();
+      _premises.push(2*_units.size()+1);
+      _units.push(prem);
+    }
+  }
+  if(!inf->extra().empty()) {
+    _extras.insert(index, inf->extra());
+  }
+
+  LoggedInference* logged=new LoggedInference(inf->rule(), index, inf->maxDepth());
+  logged->setExtra(inf->extra());
+  cl->setInference(logged);
+  inf->destroy();
+  return true;
+}
+
+/**
+ * Record the derivation of @b cl and, before it, of its premises that
+ * were not recorded yet
+ */
+void ProofLog::recordDerivation(Clause* cl)
+{
+  CALL("ProofLog::recordDerivation");
+
+  //the clauses whose literals cannot be encoded
+  static DHSet<Clause*> failed;
+  static Stack<Clause*> todo;
+  failed.reset();
+  todo.push(cl);
+  while(todo.isNonEmpty()) {
+    Clause* c=todo.top();
+    if(!canRecord(c) || failed.contains(c)) {
+      todo.pop();
+      continue;
+    }
+    //every clause on the stack is referenced by the inference of a clause
+    //below it until that one is recorded, so none is destroyed meanwhile
+    bool ready=true;
+    Inference* inf=c->inference();
+    Inference::Iterator it=inf->iterator();
+    while(inf->hasNext(it)) {
+      Unit* prem=inf->next(it);
+      if(prem->isClause() && canRecord(prem->asClause()) && !failed.contains(prem->asClause())) {
+        todo.push(prem->asClause());
+        ready=false;
+      }
+    }
+    if(!ready) {
+      continue;
+    }
+    todo.pop();
+    if(!record(c)) {
+      failed.insert(c);
+    }
+  }
+}
+
+/**
+ * Record the derivations of the live clauses, then remove the records
+ * that no LoggedInference needs.
+ *
+ * Can lead to destruction of clauses, so it can be called only when
+ * no inference is in progress.
+ */
+void ProofLog::compact()
+{
+  CALL("ProofLog::compact");
+  ASS(_enabled);
+
+  TimeCounter tc(TC_PROOF_COMPACTION);
+
+  static Stack<Clause*> live;
+  DHSet<Unit*>::Iterator uit(*Unit::liveUnits());
+  while(uit.hasNext()) {
+    Unit* u=uit.next();
+    if(u->isClause() && canRecord(u->asClause())) {
+      //the clause must not be destroyed while the premises of others are released
+      u->incRefCnt();
+      live.push(u->asClause());
+    }
+  }
+  for(unsigned i=0;i<live.size();i++) {
+    recordDerivation(live[i]);
+  }
+  while(live.isNonEmpty()) {
+    live.pop()->decRefCnt();
+  }
+
+  //mark the records needed by the inferences and, as the premises
+  //of a record precede it, then by the marked records from the last one
+  static const unsigned REMOVED=0xFFFFFFFF;
+  static DArray<unsigned> newIndex;
+  newIndex.init(_records.size(), REMOVED);
+  DHSet<Inference*>::Iterator mit(_inferences);
+  while(mit.hasNext()) {
+    newIndex[static_cast<LoggedInference*>(mit.next())->record()]=0;
+  }
+  for(unsigned i=_records.size();i>0;i--) {
+    if(newIndex[i-1]==REMOVED) {
+      continue;
+    }
+    for(unsigned j=_records[i-1].premiseStart;j<premiseEnd(i-1);j++) {
+      if(!(_premises[j]&1)) {
+        newIndex[_premises[j]/2]=0;
+      }
+    }
+  }
+
+  static Stack<Unit*> released;
+  unsigned kept=0;
+  unsigned codeKept=0;
+  unsigned premisesKept=0;
+  unsigned unitsKept=0;
+  for(unsigned i=0;i<_records.size();i++) {
+    unsigned codeStart=_records[i].codeStart;
+    unsigned premiseStart=_records[i].premiseStart;
+    unsigned cEnd=codeEnd(i);
+    unsigned pEnd=premiseEnd(i);
+    if(newIndex[i]==REMOVED) {
+      for(unsigned j=premiseStart;j<pEnd;j++) {
+        if(_premises[j]&1) {
+          released.push(_units[_premises[j]/2]);
+        }
+      }
+      continue;
+    }
+    newIndex[i]=kept;
+    Record rec=_records[i];
+    rec.codeStart=codeKept;
+    rec.premiseStart=premisesKept;
+    for(unsigned j=codeStart;j<cEnd;j++) {
+      _code[codeKept++]=_code[j];
+    }
+    for(unsigned j=premiseStart;j<pEnd;j++) {
+      unsigned prem=_premises[j];
+      if(prem&1) {
+        _units[unitsKept]=_units[prem/2];
+        prem=2*unitsKept+1;
+        unitsKept++;
+      }
+      else {
+        ASS_NEQ(newIndex[prem/2],REMOVED);
+        prem=2*newIndex[prem/2];
+      }
+      _premises[premisesKept++]=prem;
+    }
+    //records are only moved towards the start, so the unprocessed ones stay
+    _records[kept++]=rec;
+  }
+  _records.truncate(kept);
+  _code.truncate(codeKept);
+  _premises.truncate(premisesKept);
+  _units.truncate(unitsKept);
+
+  static DHMap<unsigned,vstring> extras;
+  extras.reset();
+  DHMap<unsigned,vstring>::Iterator eit(_extras);
+  while(eit.hasNext()) {
+    unsigned rec;
+    vstring extra;
+    eit.next(rec, extra);
+    if(newIndex[rec]!=REMOVED) {
+      extras.insert(newIndex[rec], extra);
+    }
+  }
+  _extras.reset();
+  _extras.loadFromMap(extras);
+
+  static DHMap<unsigned,Unit*> rebuilt;
+  rebuilt.reset();
+  DHMap<unsigned,Unit*>::Iterator rit(_rebuilt);
+  while(rit.hasNext()) {
+    unsigned rec;
+    Unit* u;
+    rit.next(rec, u);
+    //the rebuilt clauses have their own LoggedInference
+    ASS_NEQ(newIndex[rec],REMOVED);
+    rebuilt.insert(newIndex[rec], u);
+  }
+  _rebuilt.reset();
+  _rebuilt.loadFromMap(rebuilt);
+
+  DHSet<Inference*>::Iterator iit(_inferences);
+  while(iit.hasNext()) {
+    LoggedInference* inf=static_cast<LoggedInference*>(iit.next());
+    inf->_record=newIndex[inf->_record];
+  }
+
+  //this may destroy clauses and their inferences, so it comes last
+  while(released.isNonEmpty()) {
+    released.pop()->decRefCnt();
+  }
+} // ProofLog::compact
+
+/**
+ * Return the premises of the record @b record, each of them referenced
+ * once for the caller. The clauses logged are rebuilt from the log.
+ */
+UnitList* ProofLog::premises(unsigned record)
+{
+  CALL("ProofLog::premises");
+
+  UnitList* res=0;
+  for(unsigned j=premiseEnd(record);j>_records[record].premiseStart;j--) {
+    unsigned prem=_premises[j-1];
+    Unit* u=(prem&1) ? _units[prem/2] : rebuild(prem/2);
+    u->incRefCnt();
+    UnitList::push(u, res);
+  }
+  return res;
+}
+
+/**
+ * Return the clause of the record @b record. If it was destroyed, it is
+ * rebuilt with its number, age and split set, and a LoggedInference.
+ */
+Unit* ProofLog::rebuild(unsigned record)
+{
+  CALL("ProofLog::rebuild");
+
+  const Record& rec=_records[record];
+  //the number tells whether the memory was reused by another unit
+  if(Unit::liveUnits()->contains(rec.clause) && rec.clause->number()==rec.number) {
+    return rec.clause;
+  }
+
+  Unit** res;
+  if(!_rebuilt.getValuePtr(record, res)) {
+    return *res;
+  }
+
+  static Stack<Literal*> lits;
+  lits.reset();
+  const unsigned* code=_code.begin()+rec.codeStart;
+  const unsigned* end=_code.begin()+codeEnd(record);
+  while(code!=end) {
+    lits.push(CompressedClause::decodeLiteral(code));
+  }
+
+  LoggedInference* inf=new LoggedInference(rec.rule, record, 0);
+  vstring extra;
+  if(_extras.find(record, extra)) {
+    inf->setExtra(extra);
+  }
+  Clause* cl=Clause::fromStack(lits, rec.inputType, inf);
+  _records[record].clause=cl;
+  cl->_number=rec.number;
+  cl->setAge(rec.age);
+  if(rec.splits) {
+    cl->setSplits(rec.splits);
+  }
+  //the log keeps the clause until the end
+  cl->incRefCnt();
+  *res=cl;
+  return cl;
+}
+
+}
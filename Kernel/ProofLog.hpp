@@ -0,0 +1,158 @@
+
+/*
+ * File ProofLog.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ProofLog.hpp
+ * Defines classes ProofLog and LoggedInference.
+ */
+
+#ifndef __ProofLog__
+#define __ProofLog__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Inference.hpp"
+#include "Unit.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * Inference whose rule and premises are stored in a record of the
+ * proof log instead of the inference object. The premises are not
+ * referenced, so they can be destroyed when the search no longer
+ * needs them.
+ *
+ * The premises are rebuilt from the log by minimizePremises(), which
+ * InferenceStore calls before it asks for them, so that the proof can
+ * be printed. Until then the inference has no premises.
+ */
+class LoggedInference
+  : public InferenceMany
+{
+public:
+  CLASS_NAME(LoggedInference);
+  USE_ALLOCATOR(LoggedInference);
+
+  LoggedInference(Rule rule, unsigned record, unsigned maxDepth);
+  virtual ~LoggedInference();
+
+  virtual void minimizePremises() override;
+  virtual bool loggable() const override { return false; }
+
+  /** Index of the record in the proof log */
+  unsigned record() const { return _record; }
+
+private:
+  friend class ProofLog;
+
+  unsigned _record;
+  /** The premises were rebuilt from the log */
+  bool _rebuilt;
+};
+
+/**
+ * Append-only log of the derivations of clauses (see the proof_compaction
+ * option).
+ *
+ * compact() moves the inferences of the live clauses into records of the
+ * log, each holding the literals of the clause in the encoding of
+ * CompressedClause and the indexes of the records of its premises.
+ * Premises that are not logged, such as the units from preprocessing,
+ * are referenced instead. The records that cannot be reached from any
+ * LoggedInference are then removed and the remaining ones renumbered,
+ * keeping their order, so the premises of a record always precede it.
+ */
+class ProofLog
+{
+public:
+  CLASS_NAME(ProofLog);
+  USE_ALLOCATOR(ProofLog);
+
+  static ProofLog* instance();
+
+  ProofLog() : _enabled(false) {}
+
+  void enable();
+  /** True if enable() was called */
+  bool enabled() const { return _enabled; }
+
+  void compact();
+
+  /** The number of records in the log */
+  unsigned size() const { return _records.size(); }
+
+  UnitList* premises(unsigned record);
+
+private:
+  friend class LoggedInference;
+
+  /** The derivation of a clause */
+  struct Record
+  {
+    /** the clause, which may have been destroyed since */
+    Clause* clause;
+    /** number of the clause */
+    unsigned number;
+    unsigned age;
+    Inference::Rule rule;
+    /** input type passed to the Clause constructor */
+    Unit::InputType inputType;
+    SplitSet* splits;
+    /** the first element of _code encoding the literals of the clause,
+     * they end where the ones of the next record start */
+    unsigned codeStart;
+    /** the first element of _premises for the clause, ending as codeStart */
+    unsigned premiseStart;
+  };
+
+  bool canRecord(Clause* cl);
+  bool record(Clause* cl);
+  void recordDerivation(Clause* cl);
+  Unit* rebuild(unsigned record);
+
+  unsigned codeEnd(unsigned record) const
+  { return record+1<_records.size() ? _records[record+1].codeStart : _code.size(); }
+  unsigned premiseEnd(unsigned record) const
+  { return record+1<_records.size() ? _records[record+1].premiseStart : _premises.size(); }
+
+  bool _enabled;
+  Stack<Record> _records;
+  Stack<unsigned> _code;
+  /** The premises of the records, 2i for the record i and 2i+1 for
+   * the unit _units[i], which is referenced by the log */
+  Stack<unsigned> _premises;
+  Stack<Unit*> _units;
+  /** The extra information of the inferences that have some */
+  DHMap<unsigned,vstring> _extras;
+  /** The existing LoggedInference objects */
+  DHSet<Inference*> _inferences;
+  /** The clauses rebuilt from the records, referenced by the log */
+  DHMap<unsigned,Unit*> _rebuilt;
+};
+
+}
+
+#endif // __ProofLog__
@@ -57,9 +57,9 @@ namespace Kernel
 using namespace std;
 using namespace Lib;
 
-const int RobSubstitution::AUX_INDEX=-3;
-const int RobSubstitution::SPECIAL_INDEX=-2;
-const int RobSubstitution::UNBOUND_INDEX=-1;
+const int RobSubstitution::AUX_INDEX;
+const int RobSubstitution::SPECIAL_INDEX;
+const int RobSubstitution::UNBOUND_INDEX;
 
 /**
  * Unify @b t1 and @b t2, and return true iff it was successful.
@@ -217,12 +217,134 @@ void RobSubstitution::bind(const VarSpec& v, const TermSpec& b)
   ASS(!b.term.isTerm() || b.index!=AUX_INDEX || b.term.term()->shared());
   ASS_NEQ(v.index, UNBOUND_INDEX);
 
-  if(bdIsRecording()) {
+  if(_trailing) {
+    TrailEntry e;
+    e.var=v;
+    if(!_bank.find(v,e.previous)) {
+      e.previous.term.makeEmpty();
+    }
+    _trail.push(e);
+  } else if(bdIsRecording()) {
     bdAdd(new BindingBacktrackObject(this, v));
   }
   _bank.set(v,b);
 }
 
+/**
+ * Start logging bindings into @b _trail. Used by unify() and match()
+ * so that a failed attempt can be undone without allocating any
+ * backtrack objects.
+ */
+void RobSubstitution::trailStart()
+{
+  CALL("RobSubstitution::trailStart");
+  ASS(!_trailing);
+  ASS(_trail.isEmpty());
+
+  _trailing=true;
+}
+
+/**
+ * Undo all bindings logged since the last call to trailStart()
+ */
+void RobSubstitution::trailUndo()
+{
+  CALL("RobSubstitution::trailUndo");
+  ASS(_trailing);
+
+  _trailing=false;
+  while(_trail.isNonEmpty()) {
+    TrailEntry& e=_trail.top();
+    if(e.previous.term.isEmpty()) {
+      _bank.remove(e.var);
+    } else {
+      _bank.set(e.var,e.previous);
+    }
+    _trail.pop();
+  }
+}
+
+/**
+ * Keep the bindings logged since the last call to trailStart(). If the
+ * client is recording backtrack data, it receives backtrack objects
+ * for them.
+ */
+void RobSubstitution::trailCommit()
+{
+  CALL("RobSubstitution::trailCommit");
+  ASS(_trailing);
+
+  _trailing=false;
+  if(bdIsRecording()) {
+    Stack<TrailEntry>::BottomFirstIterator tit(_trail);
+    while(tit.hasNext()) {
+      const TrailEntry& e=tit.next();
+      bdAdd(new BindingBacktrackObject(this, e.var, e.previous));
+    }
+  }
+  _trail.reset();
+}
+
+void RobSubstitution::Bank::reset()
+{
+  CALL("RobSubstitution::Bank::reset");
+
+  _timestamp++;
+  if(_timestamp==0) {
+    //the timestamp overflowed, so we have to invalidate the slots explicitly
+    for(size_t i=0;i<_dense.size();i++) {
+      _dense[i].timestamp=0;
+    }
+    _timestamp=1;
+  }
+  _sparse.reset();
+}
+
+size_t RobSubstitution::Bank::size() const
+{
+  CALL("RobSubstitution::Bank::size");
+
+  size_t res=_sparse.size();
+  for(size_t i=0;i<_dense.size();i++) {
+    if(_dense[i].timestamp==_timestamp) {
+      res++;
+    }
+  }
+  return res;
+}
+
+RobSubstitution::Bank::Iterator::Iterator(const Bank& bank)
+: _bank(bank), _nextSlot(0), _sparseIt(bank._sparse)
+{
+}
+
+bool RobSubstitution::Bank::Iterator::hasNext()
+{
+  CALL("RobSubstitution::Bank::Iterator::hasNext");
+
+  while(_nextSlot<_bank._dense.size()) {
+    if(_bank._dense[_nextSlot].timestamp==_bank._timestamp) {
+      return true;
+    }
+    _nextSlot++;
+  }
+  return _sparseIt.hasNext();
+}
+
+void RobSubstitution::Bank::Iterator::next(VarSpec& var, TermSpec& binding)
+{
+  CALL("RobSubstitution::Bank::Iterator::next");
+
+  if(_nextSlot<_bank._dense.size()) {
+    var.var=_nextSlot/DENSE_BANKS;
+    var.index=static_cast<int>(_nextSlot%DENSE_BANKS)+AUX_INDEX;
+    binding=_bank._dense[_nextSlot].binding;
+    _nextSlot++;
+    return;
+  }
+  _sparseIt.next(var,binding);
+}
+
 void RobSubstitution::bindVar(const VarSpec& var, const VarSpec& to)
 {
   CALL("RobSubstitution::bindVar");
@@ -293,7 +415,8 @@ void RobSubstitution::swap(TermSpec& ts1, TermSpec& ts2)
 bool RobSubstitution::occurs(VarSpec vs, TermSpec ts)
 {
   vs=root(vs);
-  Stack<TermSpec> toDo(8);
+  static Stack<TermSpec> toDo(8);
+  toDo.reset();
   if(ts.isVar()) {
     ts=derefBound(ts);
     if(ts.isVar()) {
@@ -337,15 +460,14 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
   }
 
   bool mismatch=false;
-  BacktrackData localBD;
-  bdRecord(localBD);
+  trailStart();
 
   static Stack<TTPair> toDo(64);
   static Stack<TermList*> subterms(64);
   ASS(toDo.isEmpty() && subterms.isEmpty());
 
   typedef DHSet<TTPair,TTPairHash> EncStore;
-  EncStore encountered;
+  static EncStore encountered;
   encountered.reset();
 
   for(;;) {
@@ -383,6 +505,11 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
           ASS(s->arity() > 0);
           ASS(s->functor() == t->functor());
 
+          if (s->shared() && t->shared() && !s->couldArgsUnify(t)) {
+            mismatch=true;
+            break;
+          }
+
           ss = s->args();
           tt = t->args();
           if (! ss->next()->isEmpty()) {
@@ -419,7 +546,7 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
       }
     }
 
-    if(toDo.isEmpty()) {
+    if(mismatch || toDo.isEmpty()) {
       break;
     }
     t1=toDo.top().first;
@@ -429,17 +556,9 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
   if(mismatch) {
     subterms.reset();
     toDo.reset();
-  }
-
-  bdDone();
-
-  if(mismatch) {
-    localBD.backtrack();
+    trailUndo();
   } else {
-    if(bdIsRecording()) {
-      bdCommit(localBD);
-    }
-    localBD.drop();
+    trailCommit();
   }
 
   return !mismatch;
@@ -463,8 +582,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
   }
 
   bool mismatch=false;
-  BacktrackData localBD;
-  bdRecord(localBD);
+  trailStart();
 
   static Stack<TermList*> subterms(64);
   ASS(subterms.isEmpty());
@@ -484,6 +602,11 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
       Term* t = its.term.term();
       ASS(s->arity() > 0);
 
+      if (s->shared() && t->shared() && !t->couldArgsBeInstanceOf(s)) {
+	mismatch=true;
+	break;
+      }
+
       bt = s->args();
       it = t->args();
     } else {
@@ -536,18 +659,12 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
     }
   }
 
-  bdDone();
-
   subterms.reset();
 
-
   if(mismatch) {
-    localBD.backtrack();
+    trailUndo();
   } else {
-    if(bdIsRecording()) {
-      bdCommit(localBD);
-    }
-    localBD.drop();
+    trailCommit();
   }
 
   return !mismatch;
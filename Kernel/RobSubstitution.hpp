@@ -28,8 +28,10 @@
 #include <utility>
 
 #include "Forwards.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Backtrackable.hpp"
+#include "Lib/Stack.hpp"
 #include "Term.hpp"
 
 #if VDEBUG
@@ -52,7 +54,7 @@ public:
   CLASS_NAME(RobSubstitution);
   USE_ALLOCATOR(RobSubstitution);
   
-  RobSubstitution() : _nextUnboundAvailable(0),_nextAuxAvailable(0) {}
+  RobSubstitution() : _trailing(false), _nextUnboundAvailable(0),_nextAuxAvailable(0) {}
 
   SubstIterator matches(Literal* base, int baseIndex,
 	  Literal* instance, int instanceIndex, bool complementary);
@@ -218,9 +220,9 @@ private:
   RobSubstitution& operator=(const RobSubstitution& obj);
 
 
-  static const int AUX_INDEX;
-  static const int SPECIAL_INDEX;
-  static const int UNBOUND_INDEX;
+  static const int AUX_INDEX=-3;
+  static const int SPECIAL_INDEX=-2;
+  static const int UNBOUND_INDEX=-1;
 
   bool isUnbound(VarSpec v) const;
   TermSpec deref(VarSpec v) const;
@@ -264,10 +266,127 @@ private:
   }
   static void swap(TermSpec& ts1, TermSpec& ts2);
 
-  typedef DHMap<VarSpec,TermSpec,VarSpec::Hash1, VarSpec::Hash2> BankType;
+  /**
+   * Store of variable bindings.
+   *
+   * Variables with numbers below DENSE_VAR_LIMIT in banks from AUX_INDEX
+   * up to DENSE_MAX_INDEX are kept in a flat array indexed by the pair
+   * (variable, bank), which is grown on demand. The remaining variables
+   * are stored in a hash map. Entries of the array are invalidated by
+   * a timestamp, so reset() takes constant time.
+   */
+  class Bank
+  {
+  public:
+    Bank() : _timestamp(1) {}
+
+    bool find(const VarSpec& v, TermSpec& res) const
+    {
+      unsigned slot;
+      if(denseSlot(v, slot)) {
+        if(slot>=_dense.size() || _dense[slot].timestamp!=_timestamp) {
+          return false;
+        }
+        res=_dense[slot].binding;
+        return true;
+      }
+      return _sparse.find(v, res);
+    }
+    bool find(const VarSpec& v) const
+    {
+      TermSpec aux;
+      return find(v, aux);
+    }
+    void set(const VarSpec& v, const TermSpec& binding)
+    {
+      unsigned slot;
+      if(denseSlot(v, slot)) {
+        if(slot>=_dense.size()) {
+          _dense.expand(slot+1);
+        }
+        _dense[slot].binding=binding;
+        _dense[slot].timestamp=_timestamp;
+        return;
+      }
+      _sparse.set(v, binding);
+    }
+    void remove(const VarSpec& v)
+    {
+      unsigned slot;
+      if(denseSlot(v, slot)) {
+        ASS_L(slot,_dense.size());
+        ASS_EQ(_dense[slot].timestamp,_timestamp);
+        _dense[slot].timestamp=0;
+        return;
+      }
+      _sparse.remove(v);
+    }
+    void reset();
+    size_t size() const;
+
+    class Iterator
+    {
+    public:
+      Iterator(const Bank& bank);
+      bool hasNext();
+      void next(VarSpec& var, TermSpec& binding);
+    private:
+      const Bank& _bank;
+      size_t _nextSlot;
+      DHMap<VarSpec,TermSpec,VarSpec::Hash1, VarSpec::Hash2>::Iterator _sparseIt;
+    };
+  private:
+    /** Banks from AUX_INDEX to DENSE_MAX_INDEX are stored in the array */
+    static const int DENSE_MAX_INDEX=4;
+    static const unsigned DENSE_BANKS=DENSE_MAX_INDEX-AUX_INDEX+1;
+    static const unsigned DENSE_VAR_LIMIT=256;
+
+    inline static bool denseSlot(const VarSpec& v, unsigned& slot)
+    {
+      unsigned row=static_cast<unsigned>(v.index-AUX_INDEX);
+      if(row>=DENSE_BANKS || v.var>=DENSE_VAR_LIMIT) {
+        return false;
+      }
+      slot=v.var*DENSE_BANKS+row;
+      return true;
+    }
+
+    struct Slot
+    {
+      Slot() : timestamp(0) {}
+      TermSpec binding;
+      /** The slot is occupied iff this is equal to Bank::_timestamp */
+      unsigned timestamp;
+    };
+
+    DArray<Slot> _dense;
+    DHMap<VarSpec,TermSpec,VarSpec::Hash1, VarSpec::Hash2> _sparse;
+    unsigned _timestamp;
+  };
+
+  typedef Bank BankType;
 
   mutable BankType _bank;
 
+  /**
+   * Entry of the log of bindings made by a running unify() or match()
+   * call, used to undo them on failure without allocating backtrack
+   * objects.
+   */
+  struct TrailEntry
+  {
+    VarSpec var;
+    /** Previous binding of @b var, an empty term if it was unbound */
+    TermSpec previous;
+  };
+  /** If true, bind() records into @b _trail rather than into the backtrack data */
+  bool _trailing;
+  Stack<TrailEntry> _trail;
+
+  void trailStart();
+  void trailUndo();
+  void trailCommit();
+
   DHMap<int, int> _denormIndexes;
 
   mutable unsigned _nextUnboundAvailable;
@@ -284,6 +403,8 @@ private:
 	_term.term.makeEmpty();
       }
     }
+    BindingBacktrackObject(RobSubstitution* subst, VarSpec v, TermSpec previous)
+    :_subst(subst), _var(v), _term(previous) {}
     void backtrack()
     {
       if(_term.term.isEmpty()) {
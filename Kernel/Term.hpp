@@ -43,8 +43,7 @@
 #include "Lib/Metaiterators.hpp"
 #include "Lib/VString.hpp"
 
-// #include "MatchTag.hpp" // MS: disconnecting MatchTag, January 2017
-#define USE_MATCH_TAG 0
+#include "MatchTag.hpp"
 
 #include "Sorts.hpp"
 
@@ -507,13 +506,34 @@ public:
   inline bool couldArgsBeInstanceOf(Term* t)
   {
 #if USE_MATCH_TAG
-    ensureMatchTag();
-    t->ensureMatchTag();
+    ASS(shared());
+    ASS(t->shared());
     return matchTag().couldBeInstanceOf(t->matchTag());
 #else
     return true;
 #endif
   }
+  /**
+   * Return false if the arguments of shared terms @b this and @b t
+   * certainly do not unify. Only ground terms allow rejection: a ground
+   * term unifies with @b t only if it is an instance of @b t.
+   */
+  inline bool couldArgsUnify(Term* t)
+  {
+    ASS(shared());
+    ASS(t->shared());
+    if(ground()) {
+      if(t->ground() && !isLiteral()) {
+	//both terms are shared, so they are equal iff they are identical
+	return this==t;
+      }
+      return couldArgsBeInstanceOf(t);
+    }
+    if(t->ground()) {
+      return t->couldArgsBeInstanceOf(this);
+    }
+    return true;
+  }
 
   bool containsSubterm(TermList v);
   bool containsAllVariablesOf(Term* t);
@@ -589,11 +609,6 @@ protected:
   }
 
 #if USE_MATCH_TAG
-  inline void ensureMatchTag()
-  {
-    matchTag().ensureInit(this);
-  }
-
   inline MatchTag& matchTag()
   {
 #if ARCH_X64
@@ -602,7 +617,6 @@ protected:
     return _matchTag;
 #endif
   }
-
 #endif
 
   /** The number of this symbol in a signature */
@@ -615,6 +629,8 @@ protected:
   unsigned _hasInterpretedConstants : 1;
   /** If true, the object is an equality literal between two variables */
   unsigned _isTwoVarEquality : 1;
+  /** Set while TermSharing::collect() marks the terms in use */
+  unsigned _liveMark : 1;
   /** Weight of the symbol */
   unsigned _weight;
   union {
@@ -841,14 +857,9 @@ public:
   bool couldArgsBeInstanceOf(Literal* lit)
   {
 #if USE_MATCH_TAG
-    ensureMatchTag();
-    lit->ensureMatchTag();
-    if(commutative()) {
-      return matchTag().couldBeInstanceOf(lit->matchTag()) ||
-	  matchTag().couldBeInstanceOfReversed(lit->matchTag());
-    } else {
-      return matchTag().couldBeInstanceOf(lit->matchTag());
-    }
+    //the tag does not depend on the order of arguments,
+    //so it applies to both orientations of commutative literals
+    return matchTag().couldBeInstanceOf(lit->matchTag());
 #else
     return true;
 #endif
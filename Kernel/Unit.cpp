@@ -27,6 +27,7 @@
 
 #include "Debug/Tracer.hpp"
 
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/List.hpp"
@@ -44,6 +45,7 @@ using namespace Kernel;
 
 unsigned Unit::_firstNonPreprocessingNumber = 0;
 unsigned Unit::_lastParsingNumber = 0;
+DHSet<Unit*>* Unit::_liveUnits = 0;
 
 /**
  * Should be called after the preprocessing and before the start
@@ -118,8 +120,33 @@ Unit::Unit(Kind kind,Inference* inf,InputType it)
     break;
   }
 
+  if(_liveUnits) {
+    _liveUnits->insert(this);
+  }
 } // Unit::Unit
 
+/**
+ * Keep the set of units that were created from now on and were not
+ * destroyed yet. The term sharing uses it to find the terms in use.
+ */
+void Unit::trackLiveUnits()
+{
+  CALL("Unit::trackLiveUnits");
+
+  if(!_liveUnits) {
+    _liveUnits = new DHSet<Unit*>();
+  }
+}
+
+/** Remove the unit being destroyed from the live units */
+void Unit::forgetLive()
+{
+  CALL("Unit::forgetLive");
+  ASS(_liveUnits);
+
+  _liveUnits->remove(this);
+}
+
 unsigned Unit::getPriority() const
 {
   CALL("Unit::getPriority");
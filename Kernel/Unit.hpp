@@ -28,6 +28,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/Hash.hpp"
 #include "Lib/List.hpp"
 #include "Lib/VString.hpp"
 
@@ -43,7 +44,12 @@ using namespace Lib;
 class Unit
 {
 protected:
-  ~Unit() {}
+  ~Unit()
+  {
+    if(_liveUnits) {
+      forgetLive();
+    }
+  }
 public:
   /** Kind of unit. The integers should not be changed, they are used in
    *  Compare.
@@ -170,6 +176,11 @@ public:
   static void onParsingEnd(){ _lastParsingNumber = _lastNumber;}
   static unsigned getLastParsingNumber(){ return _lastParsingNumber;}
 
+  static void trackLiveUnits();
+  /** The units created and not destroyed since trackLiveUnits() was called,
+   * or zero if it was not called */
+  static const DHSet<Unit*>* liveUnits() { return _liveUnits; }
+
 protected:
   /** Number of this unit, used for printing and statistics */
   unsigned _number;
@@ -197,6 +208,10 @@ protected:
   static unsigned _firstNonPreprocessingNumber;
 
   static unsigned _lastParsingNumber;
+
+  void forgetLive();
+
+  static DHSet<Unit*>* _liveUnits;
 }; // class Unit
 
 std::ostream& operator<< (ostream& out, const Unit& u );
@@ -0,0 +1,176 @@
+
+/*
+ * File HardwareCounters.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file HardwareCounters.cpp
+ * Implements class HardwareCounters.
+ *
+ * The events are opened as a single group, so that one read()
+ * returns all of them, counted over the same intervals.
+ */
+
+#include <cstring>
+
+#if __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "HardwareCounters.hpp"
+
+namespace Lib
+{
+
+int HardwareCounters::s_leader = -1;
+unsigned HardwareCounters::s_used = 0;
+bool HardwareCounters::s_counted[EVENT_COUNT];
+int HardwareCounters::s_members[EVENT_COUNT];
+
+const char* HardwareCounters::eventName(Event e)
+{
+  switch(e) {
+  case CYCLES:
+    return "cycles";
+  case INSTRUCTIONS:
+    return "instructions";
+  case CACHE_MISSES:
+    return "cache_misses";
+  case BRANCH_MISSES:
+    return "branch_misses";
+  case PAGE_FAULTS:
+    return "page_faults";
+  default:
+    ASSERTION_VIOLATION;
+  }
+  return "";
+}
+
+/**
+ * Start counting the events of the current process. If the counters
+ * were open before, e.g. in the parent of a forked process, they are
+ * closed first.
+ */
+void HardwareCounters::open()
+{
+  CALL("HardwareCounters::open");
+
+  close();
+
+#if __linux__
+  for(unsigned i=0; i<EVENT_COUNT; i++) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size=sizeof(attr);
+    attr.type=PERF_TYPE_HARDWARE;
+    switch(static_cast<Event>(i)) {
+    case CYCLES:
+      attr.config=PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case INSTRUCTIONS:
+      attr.config=PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case CACHE_MISSES:
+      attr.config=PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case BRANCH_MISSES:
+      attr.config=PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case PAGE_FAULTS:
+      attr.type=PERF_TYPE_SOFTWARE;
+      attr.config=PERF_COUNT_SW_PAGE_FAULTS;
+      break;
+    default:
+      ASSERTION_VIOLATION;
+    }
+    attr.read_format=PERF_FORMAT_GROUP;
+    //counting in user space only is allowed also to unprivileged processes
+    attr.exclude_kernel=1;
+    attr.exclude_hv=1;
+
+    int fd=syscall(SYS_perf_event_open, &attr, 0, -1, s_leader, 0);
+    if(fd==-1) {
+      continue;
+    }
+    if(s_leader==-1) {
+      s_leader=fd;
+    }
+    else {
+      s_members[i]=fd;
+    }
+    s_counted[i]=true;
+    s_used++;
+  }
+#endif
+}
+
+void HardwareCounters::close()
+{
+  CALL("HardwareCounters::close");
+
+  for(unsigned i=0; i<EVENT_COUNT; i++) {
+#if __linux__
+    if(s_members[i]!=-1 && s_counted[i]) {
+      ::close(s_members[i]);
+    }
+#endif
+    s_counted[i]=false;
+    s_members[i]=-1;
+  }
+#if __linux__
+  if(s_leader!=-1) {
+    ::close(s_leader);
+  }
+#endif
+  s_leader=-1;
+  s_used=0;
+}
+
+/**
+ * Store the current values of the counters into @b values, which must
+ * have room for EVENT_COUNT values. Events that are not counted get zero.
+ */
+void HardwareCounters::read(unsigned long long* values)
+{
+  CALL("HardwareCounters::read");
+
+  for(unsigned i=0; i<EVENT_COUNT; i++) {
+    values[i]=0;
+  }
+#if __linux__
+  if(!s_used) {
+    return;
+  }
+  //the number of values followed by the values in the order of opening
+  unsigned long long buf[EVENT_COUNT+1];
+  if(::read(s_leader, buf, sizeof(buf))<static_cast<ssize_t>((s_used+1)*sizeof(unsigned long long))) {
+    return;
+  }
+  unsigned next=1;
+  for(unsigned i=0; i<EVENT_COUNT; i++) {
+    if(s_counted[i]) {
+      values[i]=buf[next++];
+    }
+  }
+#endif
+}
+
+}
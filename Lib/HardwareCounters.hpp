@@ -0,0 +1,71 @@
+
+/*
+ * File HardwareCounters.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file HardwareCounters.hpp
+ * Defines class HardwareCounters.
+ */
+
+#ifndef __HardwareCounters__
+#define __HardwareCounters__
+
+namespace Lib {
+
+/**
+ * Processor event counters of the current process, read through
+ * the perf_event_open system call of Linux.
+ *
+ * The events that the machine or the kernel settings do not allow
+ * are left out, so the set of counted events may be smaller than
+ * EVENT_COUNT or empty. Everywhere else than on Linux it is empty.
+ */
+class HardwareCounters
+{
+public:
+  enum Event {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    BRANCH_MISSES,
+    PAGE_FAULTS,
+    EVENT_COUNT
+  };
+
+  static void open();
+  static void close();
+
+  /** Return true if at least one event is counted */
+  static bool isOpen() { return s_used; }
+  static bool isCounted(Event e) { return s_counted[e]; }
+  static const char* eventName(Event e);
+
+  static void read(unsigned long long* values);
+
+private:
+  /** descriptor of the group leader, or -1 */
+  static int s_leader;
+  /** number of counted events */
+  static unsigned s_used;
+  static bool s_counted[EVENT_COUNT];
+  /** file descriptors of the events in the group other than the leader */
+  static int s_members[EVENT_COUNT];
+};
+
+}
+
+#endif // __HardwareCounters__
@@ -122,6 +122,12 @@ public:
       return s;
     }
 
+    // the sets are shared and never destroyed, so a computed union stays valid for good
+    UnionCacheEntry& ce = getUnionCacheEntry(this, s);
+    if(ce.matches(this, s)) {
+      return ce.result;
+    }
+
     bool p1Superset = true;
     bool p2Superset = true;
 
@@ -164,14 +170,17 @@ public:
     }
 
     ASS(!p1Superset || !p2Superset);
+    const SharedSet* res;
     if(p1Superset) {
-      return this;
+      res = this;
     }
-    if(p2Superset) {
-      return s;
+    else if(p2Superset) {
+      res = s;
     }
-
-    const SharedSet* res=create(acc);
+    else {
+      res = create(acc);
+    }
+    ce.set(this, s, res);
     return res;
   }
 
@@ -451,6 +460,41 @@ private:
   size_t _size;
   T _items[1];
 
+  /**
+   * Entry of a direct-mapped cache of recently computed unions.
+   * Since union is commutative, the operands are stored ordered by address.
+   */
+  struct UnionCacheEntry {
+    const SharedSet* fst;
+    const SharedSet* snd;
+    const SharedSet* result;
+
+    bool matches(const SharedSet* s1, const SharedSet* s2) const
+    {
+      return (fst==s1 && snd==s2) || (fst==s2 && snd==s1);
+    }
+    void set(const SharedSet* s1, const SharedSet* s2, const SharedSet* res)
+    {
+      fst = s1 < s2 ? s1 : s2;
+      snd = s1 < s2 ? s2 : s1;
+      result = res;
+    }
+  };
+
+  static const size_t UNION_CACHE_SIZE = 4096; // must be a power of two
+
+  static UnionCacheEntry& getUnionCacheEntry(const SharedSet* s1, const SharedSet* s2)
+  {
+    static UnionCacheEntry cache[UNION_CACHE_SIZE]; // zero-initialized, so matches nothing
+
+    // order-independent mix of the two addresses
+    size_t a = reinterpret_cast<size_t>(s1) >> 3;
+    size_t b = reinterpret_cast<size_t>(s2) >> 3;
+    size_t h = (a ^ b) * 2654435761u + (a + b);
+    h ^= h >> 15;
+    return cache[h & (UNION_CACHE_SIZE-1)];
+  }
+
 
   static bool equals(const T* arr1, const T* arr2, size_t len)
   {
@@ -21,10 +21,19 @@
  * Implements class TimeCounter.
  */
 
+#include <fstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
 #include "Debug/Assertion.hpp"
 #include "Debug/Tracer.hpp"
 
 #include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Timer.hpp"
 
@@ -43,6 +52,83 @@ int TimeCounter::s_measuredTimes[__TC_ELEMENT_COUNT];
 int TimeCounter::s_measuredTimesChildren[__TC_ELEMENT_COUNT];
 int TimeCounter::s_measureInitTimes[__TC_ELEMENT_COUNT];
 TimeCounter* TimeCounter::s_currTop = 0;
+unsigned TimeCounter::s_currPath = 0;
+
+/**
+ * A call path, i.e. a sequence of nested units starting from TC_OTHER.
+ * Paths form a tree, whose children are linked through @b nextSibling.
+ * Index 0 is the root, and so also means no child or sibling.
+ */
+struct PathNode
+{
+  TimeCounterUnit unit;
+  unsigned parent;
+  unsigned firstChild;
+  unsigned nextSibling;
+  /** cycles spent in the path, including its extensions */
+  unsigned long long cycles;
+  unsigned long long calls;
+  /**
+   * hardware counter increments in the path, including its extensions;
+   * counted only for the root and its children
+   */
+  unsigned long long events[HardwareCounters::EVENT_COUNT];
+};
+
+static Stack<PathNode> s_paths;
+/**
+ * For each path and unit, the path extending it by the unit, or zero
+ * if there is none yet. This makes entering a counter constant time.
+ */
+static Stack<unsigned> s_pathChildren;
+/** cycle counter value from which the root path is measured */
+static unsigned long long s_rootStartCycles;
+/** hardware counter values from which the root path is measured */
+static unsigned long long s_rootStartEvents[HardwareCounters::EVENT_COUNT];
+
+/**
+ * Return the processor cycle counter, or where there is none,
+ * a monotonic clock in nanoseconds
+ */
+static inline unsigned long long readCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1000000000ull+ts.tv_nsec;
+#endif
+}
+
+/**
+ * Return the path extending @b parent by @b tcu, creating it if needed
+ */
+static inline unsigned getPathChild(unsigned parent, TimeCounterUnit tcu)
+{
+  unsigned& res=s_pathChildren[parent*__TC_ELEMENT_COUNT+tcu];
+  if(res) {
+    return res;
+  }
+  PathNode n;
+  n.unit=tcu;
+  n.parent=parent;
+  n.firstChild=0;
+  n.nextSibling=s_paths[parent].firstChild;
+  n.cycles=0;
+  n.calls=0;
+  for(unsigned i=0; i<HardwareCounters::EVENT_COUNT; i++) {
+    n.events[i]=0;
+  }
+  unsigned child=s_paths.size();
+  s_paths.push(n);
+  s_paths[parent].firstChild=child;
+  res=child;
+  for(unsigned i=0; i<__TC_ELEMENT_COUNT; i++) {
+    s_pathChildren.push(0);
+  }
+  return child;
+}
 
 /**
  * Reinitializes the time counting
@@ -60,13 +146,18 @@ void TimeCounter::reinitialize()
 
   int currTime=env.timer->elapsedMilliseconds();
 
+  unsigned long long currCycles=readCycleCounter();
+
   TimeCounter* counter = s_currTop;
   while(counter) {
     s_measureInitTimes[counter->_tcu]=currTime;
+    counter->_startCycles=currCycles;
+    HardwareCounters::read(counter->_startEvents);
     counter = counter->previousTop;
   }
   // at least OTHER is running, started now
   s_measureInitTimes[TC_OTHER] = currTime;
+  s_rootStartCycles = currCycles;
 }
 
 void TimeCounter::initialize()
@@ -76,11 +167,17 @@ void TimeCounter::initialize()
 
   s_initialized=true;
 
-  if(!env.options->timeStatistics()) {
+  if(!env.options->timeStatistics() && env.options->timeProfile().empty() &&
+      !env.options->hardwareCounters()) {
     s_measuring=false;
     return;
   }
 
+  if(env.options->hardwareCounters()) {
+    //also reopens the counters in a forked process
+    HardwareCounters::open();
+  }
+
   for(int i=0; i<__TC_ELEMENT_COUNT; i++) {
     s_measuredTimes[i]=0;
     s_measuredTimesChildren[i]=0;
@@ -89,6 +186,29 @@ void TimeCounter::initialize()
 
   // OTHER is running, from time 0
   s_measureInitTimes[TC_OTHER]=0;
+
+  //after reinitialize() the paths of the running counters must stay
+  if(s_paths.isEmpty()) {
+    PathNode root;
+    root.unit=TC_OTHER;
+    root.parent=0;
+    root.firstChild=0;
+    root.nextSibling=0;
+    s_paths.push(root);
+    for(unsigned i=0; i<__TC_ELEMENT_COUNT; i++) {
+      s_pathChildren.push(0);
+    }
+  }
+  for(unsigned i=0; i<s_paths.size(); i++) {
+    s_paths[i].cycles=0;
+    s_paths[i].calls=0;
+    for(unsigned j=0; j<HardwareCounters::EVENT_COUNT; j++) {
+      s_paths[i].events[j]=0;
+    }
+  }
+  s_paths[0].calls=1;
+  s_rootStartCycles=readCycleCounter();
+  HardwareCounters::read(s_rootStartEvents);
 }
 
 void TimeCounter::startMeasuring(TimeCounterUnit tcu)
@@ -113,6 +233,15 @@ void TimeCounter::startMeasuring(TimeCounterUnit tcu)
 
   _tcu=tcu;
   s_measureInitTimes[_tcu]=currTime;
+
+  //reading the hardware counters takes a system call, which would be
+  //too costly for nested units such as term sharing
+  if(HardwareCounters::isOpen() && !s_currPath) {
+    HardwareCounters::read(_startEvents);
+  }
+  _path=getPathChild(s_currPath, tcu);
+  s_currPath=_path;
+  _startCycles=readCycleCounter();
 }
 
 void TimeCounter::stopMeasuring()
@@ -125,6 +254,19 @@ void TimeCounter::stopMeasuring()
   }
   ASS_GE(s_measureInitTimes[_tcu], 0);
 
+  PathNode& path=s_paths[_path];
+  path.cycles+=readCycleCounter()-_startCycles;
+  path.calls++;
+  if(HardwareCounters::isOpen() && !path.parent) {
+    unsigned long long events[HardwareCounters::EVENT_COUNT];
+    HardwareCounters::read(events);
+    for(unsigned i=0; i<HardwareCounters::EVENT_COUNT; i++) {
+      path.events[i]+=events[i]-_startEvents[i];
+    }
+  }
+  ASS_EQ(s_currPath,_path);
+  s_currPath=path.parent;
+
   int currTime=env.timer->elapsedMilliseconds();
   int measuredTime = currTime-s_measureInitTimes[_tcu];
   s_measuredTimes[_tcu] += measuredTime;
@@ -145,9 +287,20 @@ void TimeCounter::snapShot()
   CALL("TimeCounter::snapShot");
 
   int currTime=env.timer->elapsedMilliseconds();
+  unsigned long long currCycles=readCycleCounter();
+  unsigned long long currEvents[HardwareCounters::EVENT_COUNT];
+  HardwareCounters::read(currEvents);
 
   TimeCounter* counter = s_currTop;
   while(counter) {
+    PathNode& path=s_paths[counter->_path];
+    path.cycles += currCycles-counter->_startCycles;
+    counter->_startCycles=currCycles;
+    for(unsigned i=0; !path.parent && i<HardwareCounters::EVENT_COUNT; i++) {
+      path.events[i] += currEvents[i]-counter->_startEvents[i];
+      counter->_startEvents[i]=currEvents[i];
+    }
+
     ASS_GE(s_measureInitTimes[counter->_tcu], 0);
     int measuredTime = currTime-s_measureInitTimes[counter->_tcu];
     s_measuredTimes[counter->_tcu] += measuredTime;
@@ -165,6 +318,13 @@ void TimeCounter::snapShot()
   int measuredTime = currTime-s_measureInitTimes[TC_OTHER];
   s_measuredTimes[TC_OTHER] += measuredTime;
   s_measureInitTimes[TC_OTHER]=currTime;
+
+  s_paths[0].cycles += currCycles-s_rootStartCycles;
+  s_rootStartCycles=currCycles;
+  for(unsigned i=0; i<HardwareCounters::EVENT_COUNT; i++) {
+    s_paths[0].events[i] += currEvents[i]-s_rootStartEvents[i];
+    s_rootStartEvents[i]=currEvents[i];
+  }
 }
 
 void TimeCounter::printReport(ostream& out)
@@ -179,239 +339,307 @@ void TimeCounter::printReport(ostream& out)
     outputSingleStat(static_cast<TimeCounterUnit>(i), out);
   }
   out<<endl;
+
+  if (s_paths[0].cycles) {
+    addCommentSignForSZS(out);
+    out << "Call paths (share of cycles, own share, calls):" << endl;
+    outputPaths(out, 0, unitName(TC_OTHER), s_paths[0].cycles);
+    out<<endl;
+  }
+
+  if (env.options->hardwareCounters()) {
+    outputHardwareCounters(out);
+  }
 }
 
-void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
+/**
+ * Write the hardware counter increments spent in each unit not nested
+ * in another one into @b out, as space separated key=value pairs after
+ * the name of the unit. The units nested in it are included. Where the
+ * counters are available,
+ * the instructions per cycle and the cache misses per thousand
+ * instructions are added, which tell apart computation-bound and
+ * memory-bound units.
+ */
+void TimeCounter::outputHardwareCounters(ostream& out)
 {
-  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
+  CALL("TimeCounter::outputHardwareCounters");
+
+  static const unsigned EVENT_COUNT=HardwareCounters::EVENT_COUNT;
+
+  addCommentSignForSZS(out);
+  if (!HardwareCounters::isOpen()) {
+    out << "Hardware counters: not available" << endl << endl;
     return;
   }
+  out << "Hardware counters (per unit, including nested units):" << endl;
 
+  //the children of the root are the units not nested in another one,
+  //and the root itself is listed with what is left to it
+  unsigned long long own[EVENT_COUNT];
+  for(unsigned e=0; e<EVENT_COUNT; e++) {
+    own[e]=s_paths[0].events[e];
+  }
+  for(unsigned c=s_paths[0].firstChild; c; c=s_paths[c].nextSibling) {
+    outputEvents(out, s_paths[c].unit, s_paths[c].events);
+    for(unsigned e=0; e<EVENT_COUNT; e++) {
+      own[e]-=s_paths[c].events[e];
+    }
+  }
+  outputEvents(out, TC_OTHER, own);
+  out << endl;
+}
+
+void TimeCounter::outputEvents(ostream& out, TimeCounterUnit tcu, const unsigned long long* events)
+{
+  addCommentSignForSZS(out);
+  out << unitName(tcu) << ":";
+  for(unsigned e=0; e<HardwareCounters::EVENT_COUNT; e++) {
+    HardwareCounters::Event ev=static_cast<HardwareCounters::Event>(e);
+    if(HardwareCounters::isCounted(ev)) {
+      out << " " << HardwareCounters::eventName(ev) << "=" << events[e];
+    }
+  }
+  unsigned long long cycles=events[HardwareCounters::CYCLES];
+  unsigned long long instrs=events[HardwareCounters::INSTRUCTIONS];
+  if(cycles && instrs) {
+    out << " ipc=" << (static_cast<double>(instrs)/cycles);
+  }
+  if(instrs && HardwareCounters::isCounted(HardwareCounters::CACHE_MISSES)) {
+    out << " cache_mpki=" << (1000.0*events[HardwareCounters::CACHE_MISSES]/instrs);
+  }
+  out << endl;
+}
+
+/**
+ * Write the call paths of the subtree rooted at @b path into @b out,
+ * one per line, in the order of a depth-first traversal. Shares are
+ * relative to @b total cycles.
+ */
+void TimeCounter::outputPaths(ostream& out, unsigned path, vstring name, unsigned long long total)
+{
+  CALL("TimeCounter::outputPaths");
+
+  unsigned long long own=s_paths[path].cycles;
+  for(unsigned c=s_paths[path].firstChild; c; c=s_paths[c].nextSibling) {
+    own-=s_paths[c].cycles;
+  }
   addCommentSignForSZS(out);
+  out << name << ": " << (100.0*s_paths[path].cycles/total) << "% ( own "
+      << (100.0*own/total) << "% ) " << s_paths[path].calls << endl;
+  for(unsigned c=s_paths[path].firstChild; c; c=s_paths[c].nextSibling) {
+    outputPaths(out, c, name+";"+unitName(s_paths[c].unit), total);
+  }
+}
+
+/**
+ * Write the cycles spent in each call path into the file @b fileName
+ * in the collapsed stack format read by flame graph tools: a line for
+ * each path, with the names of its units separated by semicolons and
+ * followed by the cycles spent in the path but not in its extensions.
+ */
+void TimeCounter::saveProfile(vstring fileName)
+{
+  CALL("TimeCounter::saveProfile");
+
+  if(!s_measuring || s_paths.isEmpty()) {
+    return;
+  }
+  snapShot();
+
+  BYPASSING_ALLOCATOR;
+
+  ofstream out(fileName.c_str());
+  if(!out.is_open()) {
+    USER_ERROR("Cannot open time profile file: "+fileName);
+  }
+  //a path is created after its parent, so the names can be built in order
+  Stack<vstring> names;
+  for(unsigned i=0; i<s_paths.size(); i++) {
+    PathNode& n=s_paths[i];
+    names.push(i ? names[n.parent]+";"+unitName(n.unit) : vstring(unitName(TC_OTHER)));
+    unsigned long long own=n.cycles;
+    for(unsigned c=n.firstChild; c; c=s_paths[c].nextSibling) {
+      own-=s_paths[c].cycles;
+    }
+    if(own) {
+      out << names[i] << " " << own << endl;
+    }
+  }
+}
+
+/**
+ * Return the name of the unit @b tcu as used in the reports
+ */
+const char* TimeCounter::unitName(TimeCounterUnit tcu)
+{
   switch(tcu) {
   case TC_RAND_OPT:
-    out << "random option generation";
-    break;
+    return "random option generation";
   case TC_BACKWARD_DEMODULATION:
-    out<<"backward demodulation";
-    break;
+    return "backward demodulation";
   case TC_BACKWARD_SUBSUMPTION:
-    out<<"backward subsumption";
-    break;
+    return "backward subsumption";
   case TC_BACKWARD_SUBSUMPTION_RESOLUTION:
-    out<<"backward subsumption resolution";
-    break;
+    return "backward subsumption resolution";
   case TC_BDD:
-    out<<"BDD operations";
-    break;
+    return "BDD operations";
   case TC_BDD_CLAUSIFICATION:
-    out<<"BDD clausification";
-    break;
+    return "BDD clausification";
   case TC_BDD_MARKING_SUBSUMPTION:
-    out<<"BDD marking subsumption";
-    break;
+    return "BDD marking subsumption";
   case TC_INTERPRETED_EVALUATION:
-    out<<"interpreted evaluation";
-    break;
+    return "interpreted evaluation";
   case TC_INTERPRETED_SIMPLIFICATION:
-    out<<"interpreted simplification";
-    break;
+    return "interpreted simplification";
   case TC_CONDENSATION:
-    out<<"condensation";
-    break;
+    return "condensation";
   case TC_CONSEQUENCE_FINDING:
-    out<<"consequence finding";
-    break;
+    return "consequence finding";
   case TC_FORWARD_DEMODULATION:
-    out<<"forward demodulation";
-    break;
+    return "forward demodulation";
   case TC_FORWARD_SUBSUMPTION:
-    out<<"forward subsumption";
-    break;
+    return "forward subsumption";
   case TC_FORWARD_SUBSUMPTION_RESOLUTION:
-    out<<"forward subsumption resolution";
-    break;
+    return "forward subsumption resolution";
   case TC_FORWARD_LITERAL_REWRITING:
-    out<<"forward literal rewriting";
-    break;
+    return "forward literal rewriting";
   case TC_GLOBAL_SUBSUMPTION:
-    out<<"global subsumption";
-    break;
+    return "global subsumption";
   case TC_SIMPLIFYING_UNIT_LITERAL_INDEX_MAINTENANCE:
-    out<<"unit clause index maintenance";
-    break;
+    return "unit clause index maintenance";
   case TC_NON_UNIT_LITERAL_INDEX_MAINTENANCE:
-    out<<"non unit clause index maintenance";
-    break;
+    return "non unit clause index maintenance";
   case TC_FORWARD_SUBSUMPTION_INDEX_MAINTENANCE:
-    out<<"forward subsumption index maintenance";
-    break;
+    return "forward subsumption index maintenance";
   case TC_BINARY_RESOLUTION_INDEX_MAINTENANCE:
-    out<<"binary resolution index maintenance";
-    break;
+    return "binary resolution index maintenance";
   case TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE:
-    out<<"backward subsumption index maintenance";
-    break;
+    return "backward subsumption index maintenance";
   case TC_BACKWARD_SUPERPOSITION_INDEX_MAINTENANCE:
-    out<<"backward superposition index maintenance";
-    break;
+    return "backward superposition index maintenance";
   case TC_FORWARD_SUPERPOSITION_INDEX_MAINTENANCE:
-    out<<"forward superposition index maintenance";
-    break;
+    return "forward superposition index maintenance";
   case TC_BACKWARD_DEMODULATION_INDEX_MAINTENANCE:
-    out<<"backward demodulation index maintenance";
-    break;
+    return "backward demodulation index maintenance";
   case TC_FORWARD_DEMODULATION_INDEX_MAINTENANCE:
-    out<<"forward demodulation index maintenance";
-    break;
+    return "forward demodulation index maintenance";
   case TC_SPLITTING_COMPONENT_INDEX_MAINTENANCE:
-    out<<"splitting component index maintenance";
-    break;
+    return "splitting component index maintenance";
   case TC_SPLITTING_COMPONENT_INDEX_USAGE:
-    out<<"splitting component index usage";
-    break;
+    return "splitting component index usage";
   case TC_SPLITTING_MODEL_UPDATE:
-    out<<"splitting model update";
-    break;
+    return "splitting model update";
   case TC_CONGRUENCE_CLOSURE:
-    out<<"congruence closure";
-    break;
+    return "congruence closure";
   case TC_CCMODEL:
-    out<<"model from congruence closure";
-    break;
+    return "model from congruence closure";
+  case TC_LINEAR_ARITHMETIC:
+    return "ground linear arithmetic";
   case TC_INST_GEN_SAT_SOLVING:
-    out<<"inst gen SAT solving";
-    break;
+    return "inst gen SAT solving";
   case TC_INST_GEN_SIMPLIFICATIONS:
-    out<<"inst gen simplifications";
-    break;
+    return "inst gen simplifications";
   case TC_INST_GEN_VARIANT_DETECTION:
-    out<<"inst gen variant detection";
-    break;
+    return "inst gen variant detection";
   case TC_INST_GEN_GEN_INST:
-    out<<"inst gen generating instances";
-    break;
+    return "inst gen generating instances";
   case TC_LRS_LIMIT_MAINTENANCE:
-    out<<"LRS limit maintenance";
-    break;
+    return "LRS limit maintenance";
   case TC_LITERAL_REWRITE_RULE_INDEX_MAINTENANCE:
-    out<<"literal rewrite rule index maintenance";
-    break;
+    return "literal rewrite rule index maintenance";
   case TC_OTHER:
-    out<<"other";
-    break;
+    return "other";
   case TC_PARSING:
-    out<<"parsing";
-    break;
+    return "parsing";
   case TC_PREPROCESSING:
-    out<<"preprocessing";
-    break;
+    return "preprocessing";
   case TC_BCE:
-    out<<"blocked clause elimination";
-    break;
+    return "blocked clause elimination";
   case TC_PROPERTY_EVALUATION:
-    out<<"property evaluation";
-    break;
+    return "property evaluation";
   case TC_SINE_SELECTION:
-    out<<"sine selection";
-    break;
+    return "sine selection";
   case TC_RESOLUTION:
-    out<<"resolution";
-    break;
+    return "resolution";
   case TC_UR_RESOLUTION:
-    out<<"unit resulting resolution";
-    break;
+    return "unit resulting resolution";
   case TC_SAT_SOLVER:
-    out<<"SAT solver time";
-    break;
+    return "SAT solver time";
   case TC_TWLSOLVER_ADD:
-    out<<"TWLSolver add clauses";
-    break;
-    break;
+    return "TWLSolver add clauses";
   case TC_MINIMIZING_SOLVER:
-    out << "minimizing solver time";
-    break;
+    return "minimizing solver time";
   case TC_SAT_PROOF_MINIMIZATION:
-    out << "sat proof minimization";
-    break;
+    return "sat proof minimization";
   case TC_SUPERPOSITION:
-    out<<"superposition";
-    break;
+    return "superposition";
   case TC_LITERAL_ORDER_AFTERCHECK:
-    out<<"literal order aftercheck";
-    break;
+    return "literal order aftercheck";
   case TC_HYPER_SUPERPOSITION:
-    out<<"hyper superposition";
-    break;
+    return "hyper superposition";
   case TC_TERM_SHARING:
-    out<<"term sharing";
-    break;
+    return "term sharing";
+  case TC_TERM_COLLECTION:
+    return "term collection";
+  case TC_PROOF_COMPACTION:
+    return "proof compaction";
   case TC_TRIVIAL_PREDICATE_REMOVAL:
-    out<<"trivial predicate removal";
-    break;
+    return "trivial predicate removal";
   case TC_SOLVING:
-    out << "Bound propagation solving";
-    break;
+    return "Bound propagation solving";
   case TC_BOUND_PROPAGATION:
-    out << "Bound propagation";
-    break;
+    return "Bound propagation";
   case TC_HANDLING_CONFLICTS:
-    out << "handling conflicts";
-    break;
+    return "handling conflicts";
   case TC_VARIABLE_SELECTION:
-    out << "variable selection";
-    break;
+    return "variable selection";
   case TC_DISMATCHING:
-    out << "dismatching";
-    break;
+    return "dismatching";
   case TC_FMB_DEF_INTRO:
-    out << "fmb definition introduction";
-    break;
+    return "fmb definition introduction";
   case TC_FMB_SORT_INFERENCE:
-    out << "fmb sort inference"; 
-    break;
+    return "fmb sort inference";
   case TC_FMB_FLATTENING:
-    out << "fmb flattening";
-    break;
+    return "fmb flattening";
   case TC_FMB_SPLITTING:
-    out << "fmb splitting";
-    break;
+    return "fmb splitting";
   case TC_FMB_SAT_SOLVING:
-    out << "fmb sat solving";
-    break;
+    return "fmb sat solving";
   case TC_FMB_CONSTRAINT_CREATION:
-    out << "fmb constraint creation";
-    break;
+    return "fmb constraint creation";
   case TC_HCVI_COMPUTE_HASH:
-    out << "hvci compute hash";
-    break;
+    return "hvci compute hash";
   case TC_HCVI_INSERT:
-    out << "hvci insert";
-    break;
+    return "hvci insert";
   case TC_HCVI_RETRIEVE:
-      out << "hvci retrieve";
-      break;
+    return "hvci retrieve";
   case TC_MINISAT_ELIMINATE_VAR:
-    out << "minisat eliminate var";
-    break;
+    return "minisat eliminate var";
   case TC_MINISAT_BWD_SUBSUMPTION_CHECK:
-      out << "minisat bwd subsumption check";
-      break;
+    return "minisat bwd subsumption check";
   case TC_Z3_IN_FMB:
-    out << "smt search for next domain size assignment";
-    break;
+    return "smt search for next domain size assignment";
   case TC_NAMING:
-    out << "naming";
+    return "naming";
   case TC_LITERAL_SELECTION:
-    out << "literal selection";
-    break;
+    return "literal selection";
   case TC_THEORY_INST_SIMP:
-    out << "theory instantiation and simplification";
-    break;
+    return "theory instantiation and simplification";
   default:
     ASSERTION_VIOLATION;
   }
-  out<<": ";
+  return "";
+}
+
+void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
+{
+  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
+    return;
+  }
+
+  addCommentSignForSZS(out);
+  out<<unitName(tcu)<<": ";
 
   Timer::printMSString(out, s_measuredTimes[tcu]);
 
@@ -27,6 +27,9 @@
 
 #include <ostream>
 
+#include "Lib/HardwareCounters.hpp"
+#include "Lib/VString.hpp"
+
 namespace Lib {
 
 using namespace std;
@@ -46,9 +49,12 @@ enum TimeCounterUnit
   TC_MINIMIZING_SOLVER,
   TC_SAT_PROOF_MINIMIZATION,
   TC_TERM_SHARING,
+  TC_TERM_COLLECTION,
+  TC_PROOF_COMPACTION,
   TC_SPLITTING_MODEL_UPDATE,
   TC_CONGRUENCE_CLOSURE,
   TC_CCMODEL,
+  TC_LINEAR_ARITHMETIC,
   TC_SIMPLIFYING_UNIT_LITERAL_INDEX_MAINTENANCE,
   TC_NON_UNIT_LITERAL_INDEX_MAINTENANCE,
   TC_FORWARD_SUBSUMPTION_INDEX_MAINTENANCE,
@@ -125,6 +131,7 @@ public:
   }
 
   static void printReport(ostream& out);
+  static void saveProfile(vstring fileName);
 
 
   /**
@@ -150,7 +157,11 @@ private:
   void stopMeasuring();
 
   static void initialize();
+  static const char* unitName(TimeCounterUnit tcu);
   static void outputSingleStat(TimeCounterUnit tcu, ostream& out);
+  static void outputPaths(ostream& out, unsigned path, vstring name, unsigned long long total);
+  static void outputHardwareCounters(ostream& out);
+  static void outputEvents(ostream& out, TimeCounterUnit tcu, const unsigned long long* events);
 
   /**
    * Record measurements of all timers currently running,
@@ -160,6 +171,16 @@ private:
 
   TimeCounterUnit _tcu;
 
+  /** Call path of this counter, see s_currPath */
+  unsigned _path;
+  /** Value of the cycle counter when the measurement started */
+  unsigned long long _startCycles;
+  /**
+   * Values of the hardware counters when the measurement started, if
+   * this counter is not nested in another one
+   */
+  unsigned long long _startEvents[HardwareCounters::EVENT_COUNT];
+
   /**
    * Current top level counter.
    *
@@ -201,6 +222,13 @@ private:
    * block in the unit.
    */
   static int s_measureInitTimes[];
+
+  /**
+   * Call path of the current top level counter, as an index into the
+   * tree of call paths kept in TimeCounter.cpp. Each path accumulates
+   * the processor cycles spent in it and the number of its calls.
+   */
+  static unsigned s_currPath;
 };
 
 };
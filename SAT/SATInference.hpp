@@ -134,6 +134,7 @@ public:
       InferenceMany(rule,premises), _minimized(false), _satPremises(satPremises) {}
 
   virtual void minimizePremises() override;
+  virtual bool loggable() const override { return _minimized; }
 
   CLASS_NAME(InferenceFromSatRefutation);
   USE_ALLOCATOR(InferenceFromSatRefutation);
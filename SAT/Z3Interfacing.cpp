@@ -53,7 +53,7 @@ using namespace Lib;
 Z3Interfacing::Z3Interfacing(const Shell::Options& opts,SAT2FO& s2f, bool unsatCoresForAssumptions):
   _varCnt(0), sat2fo(s2f),_status(SATISFIABLE), _solver(_context),
   _model((_solver.check(),_solver.get_model())), _assumptions(_context), _unsatCoreForAssumptions(unsatCoresForAssumptions),
-  _showZ3(opts.showZ3()),_unsatCoreForRefutations(opts.z3UnsatCores())
+  _showZ3(opts.showZ3()),_unsatCoreForRefutations(opts.z3UnsatCores()), _translationAssertions(0)
 {
   CALL("Z3Interfacing::Z3Interfacing");
   _solver.reset();
@@ -341,15 +341,52 @@ z3::sort Z3Interfacing::getz3sort(unsigned s)
 */
 }
 
+/**
+ * Translate a Vampire term into a Z3 term
+ *
+ * Terms are shared, so the translation of a term is kept and returned
+ * again, unless it added assertions to the solver, which would be lost
+ * when the solver is reset.
+ */
+z3::expr Z3Interfacing::getz3expr(Term* trm,bool isLit,bool&nameExpression,bool withGuard)
+{
+  CALL("Z3Interfacing::getz3expr");
+
+  CachedExpr cached;
+  if(_exprCache[withGuard].find(trm,cached)){
+    if(cached.named){
+      nameExpression = true;
+    }
+    return z3::expr(_context,cached.ast);
+  }
+
+  unsigned assertions = _translationAssertions;
+  bool named = false;
+  z3::expr res = translate(trm,isLit,named,withGuard);
+  if(named){
+    nameExpression = true;
+  }
+  if(assertions==_translationAssertions){
+    cached.ast = res;
+    cached.named = named;
+    Z3_inc_ref(_context,cached.ast);
+    _exprCache[withGuard].insert(trm,cached);
+    if(trm->shared()){
+      env.sharing->pin(trm);
+    }
+  }
+  return res;
+}
+
 /**
  * Translate a Vampire term into a Z3 term
  * - Assumes term is ground
  * - Translates the ground structure
  * - Some interpreted functions/predicates are handled
  */
-z3::expr Z3Interfacing::getz3expr(Term* trm,bool isLit,bool&nameExpression,bool withGuard)
+z3::expr Z3Interfacing::translate(Term* trm,bool isLit,bool&nameExpression,bool withGuard)
 {
-  CALL("Z3Interfacing::getz3expr");
+  CALL("Z3Interfacing::translate");
   BYPASSING_ALLOCATOR;
   ASS(trm);
   ASS(trm->ground());
@@ -795,6 +832,8 @@ void Z3Interfacing::addIntNonZero(z3::expr t)
 {
   CALL("Z3Interfacing::addIntNonZero");
 
+  _translationAssertions++;
+
    z3::expr zero = _context.int_val(0);
 
   _solver.add(t != zero);
@@ -804,6 +843,8 @@ void Z3Interfacing::addRealNonZero(z3::expr t)
 {
   CALL("Z3Interfacing::addRealNonZero");
 
+  _translationAssertions++;
+
    z3::expr zero = _context.real_val(0);
    z3::expr side = t!=zero;
   if(_showZ3){
@@ -823,6 +864,8 @@ void Z3Interfacing::addTruncatedOperations(z3::expr_vector args, Interpretation
 {
   CALL("Z3Interfacing::addTruncatedOperations");
   
+  _translationAssertions++;
+
   unsigned qfun = env.signature->getInterpretingSymbol(qi);
   Signature::Symbol* qsymb = env.signature->getFunction(qfun); 
   ASS(qsymb);
@@ -887,6 +930,8 @@ void Z3Interfacing::addFloorOperations(z3::expr_vector args, Interpretation qi,
 {
   CALL("Z3Interfacing::addFloorOperations");
 
+  _translationAssertions++;
+
   unsigned qfun = env.signature->getInterpretingSymbol(qi);
   Signature::Symbol* qsymb = env.signature->getFunction(qfun);
   z3::symbol qs = _context.str_symbol(qsymb->name().c_str());
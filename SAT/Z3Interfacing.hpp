@@ -179,8 +179,28 @@ public:
   z3::expr getz3expr(Term* trm,bool islit,bool&nameExpression, bool withGuard=false);
   Term* evaluateInModel(Term* trm);
 private:
+  z3::expr translate(Term* trm,bool islit,bool&nameExpression, bool withGuard);
   z3::expr getRepresentation(SATLiteral lit,bool withGuard);
 
+  /**
+   * A translation of a term kept by getz3expr(). The ast is referenced
+   * by the cache and lives as long as the context.
+   */
+  struct CachedExpr
+  {
+    Z3_ast ast;
+    /** the translation sets nameExpression */
+    bool named;
+  };
+  /**
+   * Translations of the terms whose translation added no assertions to
+   * the solver, the first without and the second with guards. They are
+   * kept when the solver is reset.
+   */
+  DHMap<Term*,CachedExpr> _exprCache[2];
+  /** number of assertions added by the translation of terms */
+  unsigned _translationAssertions;
+
   Status _status;
   z3::context _context;
   z3::solver _solver;
@@ -0,0 +1,372 @@
+
+/*
+ * File Checkpoint.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Checkpoint.cpp
+ * Implements class Checkpoint.
+ *
+ * A checkpoint file is a sequence of unsigned words in the byte order
+ * of the machine that wrote it: the magic number and the version, then
+ * for functions, predicates and sorts their count followed by the arity,
+ * the name length and the name (padded to whole words) of each symbol,
+ * and finally the number of clauses and their records.
+ */
+
+#include <fstream>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/CompressedClause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "Checkpoint.hpp"
+
+namespace Saturation
+{
+
+using namespace std;
+
+/** "VCKP" read as a little-endian word */
+static const unsigned CHECKPOINT_MAGIC = 0x504b4356;
+static const unsigned CHECKPOINT_VERSION = 1;
+
+enum SymbolKind {
+  SK_FUNCTION,
+  SK_PREDICATE,
+  SK_SORT
+};
+
+static unsigned symbolCount(SymbolKind kind)
+{
+  switch(kind) {
+  case SK_FUNCTION:
+    return env.signature->functions();
+  case SK_PREDICATE:
+    return env.signature->predicates();
+  case SK_SORT:
+    return env.sorts->count();
+  }
+  ASSERTION_VIOLATION;
+}
+
+static unsigned symbolArity(SymbolKind kind, unsigned i)
+{
+  switch(kind) {
+  case SK_FUNCTION:
+    return env.signature->functionArity(i);
+  case SK_PREDICATE:
+    return env.signature->predicateArity(i);
+  case SK_SORT:
+    return 0;
+  }
+  ASSERTION_VIOLATION;
+}
+
+static vstring symbolName(SymbolKind kind, unsigned i)
+{
+  switch(kind) {
+  case SK_FUNCTION:
+    return env.signature->functionName(i);
+  case SK_PREDICATE:
+    return env.signature->predicateName(i);
+  case SK_SORT:
+    return env.sorts->sortName(i);
+  }
+  ASSERTION_VIOLATION;
+}
+
+static void writeWord(ofstream& out, unsigned w)
+{
+  out.write(reinterpret_cast<const char*>(&w), sizeof(unsigned));
+}
+
+/**
+ * Reader of the words of a checkpoint file, which reports
+ * a truncated file as a user error
+ */
+class CheckpointReader
+{
+public:
+  CheckpointReader(const Stack<unsigned>& words, vstring fileName)
+  : _cur(words.begin()), _end(words.end()), _fileName(fileName) {}
+
+  unsigned next()
+  {
+    need(1);
+    return *(_cur++);
+  }
+
+  /** Return the next @b n words and move past them */
+  const unsigned* skip(unsigned n)
+  {
+    need(n);
+    const unsigned* res=_cur;
+    _cur+=n;
+    return res;
+  }
+private:
+  void need(unsigned n)
+  {
+    if(static_cast<size_t>(_end-_cur)<n) {
+      USER_ERROR("Checkpoint file is truncated: "+_fileName);
+    }
+  }
+
+  const unsigned* _cur;
+  const unsigned* _end;
+  vstring _fileName;
+};
+
+static void writeSymbols(ofstream& out, SymbolKind kind)
+{
+  unsigned cnt=symbolCount(kind);
+  writeWord(out, cnt);
+  for(unsigned i=0;i<cnt;i++) {
+    vstring name=symbolName(kind, i);
+    writeWord(out, symbolArity(kind, i));
+    writeWord(out, name.size());
+    unsigned padded=(name.size()+sizeof(unsigned)-1)/sizeof(unsigned)*sizeof(unsigned);
+    name.resize(padded, '\0');
+    out.write(name.data(), padded);
+  }
+}
+
+/**
+ * Read the symbols of one kind and check that those present in the
+ * current signature have the same names and arities. Return the number
+ * of symbols that clauses of the checkpoint can use.
+ */
+static unsigned readSymbols(CheckpointReader& rd, SymbolKind kind, vstring fileName)
+{
+  unsigned cnt=rd.next();
+  unsigned current=symbolCount(kind);
+  for(unsigned i=0;i<cnt;i++) {
+    unsigned arity=rd.next();
+    unsigned len=rd.next();
+    const unsigned* nameWords=rd.skip((len+sizeof(unsigned)-1)/sizeof(unsigned));
+    if(i>=current) {
+      continue;
+    }
+    vstring name(reinterpret_cast<const char*>(nameWords), len);
+    if(arity!=symbolArity(kind, i) || name!=symbolName(kind, i)) {
+      USER_ERROR("Checkpoint file "+fileName+" was saved for a different problem: saved symbol "+
+	  name+" differs from "+symbolName(kind, i));
+    }
+  }
+  return Int::min(cnt, current);
+}
+
+/**
+ * Add @b cl to the checkpoint. Clauses that depend on splitting or
+ * cannot be encoded are skipped.
+ */
+void Checkpoint::addClause(Clause* cl, bool active)
+{
+  CALL("Checkpoint::addClause/2");
+
+  if(!cl->noSplits()) {
+    return;
+  }
+
+  size_t start=_records.size();
+  _records.push(active ? 1 : 0);
+  _records.push(cl->age());
+  _records.push(cl->inputType());
+  _records.push(cl->length());
+  _records.push(0);
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    if(!CompressedClause::encodeLiteral((*cl)[i], _records)) {
+      _records.truncate(start);
+      return;
+    }
+  }
+  _records[start+4]=_records.size()-start-5;
+  _clauseCnt++;
+}
+
+/**
+ * Add a passive clause kept compressed to the checkpoint
+ */
+void Checkpoint::addClause(CompressedClause* ccl)
+{
+  CALL("Checkpoint::addClause/1");
+
+  _records.push(0);
+  _records.push(ccl->age());
+  _records.push(ccl->inputType());
+  _records.push(ccl->length());
+  _records.push(ccl->codeSize());
+  for(unsigned i=0;i<ccl->codeSize();i++) {
+    _records.push(ccl->code()[i]);
+  }
+  _clauseCnt++;
+}
+
+void Checkpoint::save(vstring fileName)
+{
+  CALL("Checkpoint::save");
+
+  BYPASSING_ALLOCATOR;
+
+  ofstream out(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+  if(!out.is_open()) {
+    USER_ERROR("Cannot open checkpoint file for writing: "+fileName);
+  }
+  writeWord(out, CHECKPOINT_MAGIC);
+  writeWord(out, CHECKPOINT_VERSION);
+  writeSymbols(out, SK_FUNCTION);
+  writeSymbols(out, SK_PREDICATE);
+  writeSymbols(out, SK_SORT);
+  writeWord(out, _clauseCnt);
+  out.write(reinterpret_cast<const char*>(_records.begin()), _records.size()*sizeof(unsigned));
+  out.close();
+  if(out.fail()) {
+    USER_ERROR("Cannot write checkpoint file: "+fileName);
+  }
+  env.statistics->checkpointClauses+=_clauseCnt;
+}
+
+/**
+ * Check that @b code starts with a term whose symbols are less
+ * than the given bound, and move it past the term
+ */
+bool Checkpoint::checkTerm(const unsigned*& code, const unsigned* end, unsigned functions)
+{
+  CALL("Checkpoint::checkTerm");
+
+  unsigned pending=1;
+  while(pending) {
+    if(code==end) {
+      return false;
+    }
+    unsigned c=*(code++);
+    pending--;
+    if(c&1) {
+      continue;
+    }
+    if(c/2>=functions) {
+      return false;
+    }
+    pending+=env.signature->functionArity(c/2);
+  }
+  return true;
+}
+
+bool Checkpoint::checkLiteral(const unsigned*& code, const unsigned* end,
+    unsigned functions, unsigned predicates, unsigned sorts)
+{
+  CALL("Checkpoint::checkLiteral");
+
+  if(code==end) {
+    return false;
+  }
+  unsigned pred=*(code++)/2;
+  if(pred>=predicates) {
+    return false;
+  }
+  unsigned arity;
+  if(pred==0) {
+    //the sort of the equality
+    if(code==end || *(code++)>=sorts) {
+      return false;
+    }
+    arity=2;
+  } else {
+    arity=env.signature->predicateArity(pred);
+  }
+  for(unsigned i=0;i<arity;i++) {
+    if(!checkTerm(code, end, functions)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Load the clauses saved in the checkpoint file @b fileName into
+ * @b active and @b passive. The clauses get the CHECKPOINT inference
+ * and their saved age and input type. Records using symbols that are
+ * not in the current signature are skipped.
+ */
+void Checkpoint::load(vstring fileName, ClauseStack& active, ClauseStack& passive)
+{
+  CALL("Checkpoint::load");
+
+  Stack<unsigned> words;
+  {
+    BYPASSING_ALLOCATOR;
+
+    ifstream in(fileName.c_str(), ios::in | ios::binary);
+    if(!in.is_open()) {
+      USER_ERROR("Cannot open checkpoint file: "+fileName);
+    }
+    unsigned w;
+    while(in.read(reinterpret_cast<char*>(&w), sizeof(unsigned))) {
+      words.push(w);
+    }
+  }
+
+  CheckpointReader rd(words, fileName);
+  if(rd.next()!=CHECKPOINT_MAGIC || rd.next()!=CHECKPOINT_VERSION) {
+    USER_ERROR("Not a checkpoint file: "+fileName);
+  }
+  unsigned functions=readSymbols(rd, SK_FUNCTION, fileName);
+  unsigned predicates=readSymbols(rd, SK_PREDICATE, fileName);
+  unsigned sorts=readSymbols(rd, SK_SORT, fileName);
+
+  static Stack<Literal*> lits;
+  unsigned clauseCnt=rd.next();
+  for(unsigned i=0;i<clauseCnt;i++) {
+    bool isActive=rd.next();
+    unsigned age=rd.next();
+    unsigned inputType=rd.next();
+    unsigned length=rd.next();
+    unsigned codeSize=rd.next();
+    const unsigned* code=rd.skip(codeSize);
+    const unsigned* end=code+codeSize;
+
+    const unsigned* check=code;
+    bool valid=length && inputType<=Unit::CLAIM;
+    for(unsigned j=0;valid && j<length;j++) {
+      valid=checkLiteral(check, end, functions, predicates, sorts);
+    }
+    if(!valid || check!=end) {
+      continue;
+    }
+
+    lits.reset();
+    for(unsigned j=0;j<length;j++) {
+      lits.push(CompressedClause::decodeLiteral(code));
+    }
+    Clause* cl=Clause::fromStack(lits, static_cast<Unit::InputType>(inputType),
+	new Inference(Inference::CHECKPOINT));
+    cl->setAge(age);
+    (isActive ? active : passive).push(cl);
+    env.statistics->resumedClauses++;
+  }
+}
+
+}
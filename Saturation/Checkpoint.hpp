@@ -0,0 +1,76 @@
+
+/*
+ * File Checkpoint.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Checkpoint.hpp
+ * Defines class Checkpoint.
+ */
+
+#ifndef __Checkpoint__
+#define __Checkpoint__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Clauses of an interrupted proof search saved to a file, from which
+ * a later run on the same problem can continue (see the checkpoint_file
+ * and resume_file options).
+ *
+ * Clauses are stored in the code of CompressedClause, together with
+ * their age and input type and whether they were active. The file
+ * starts with the names and arities of the symbols, which must be
+ * the same when the checkpoint is loaded, as clauses refer to symbols
+ * by their numbers. Clauses that depend on splitting are not saved;
+ * they are derived again after the resume.
+ */
+class Checkpoint
+{
+public:
+  CLASS_NAME(Checkpoint);
+  USE_ALLOCATOR(Checkpoint);
+
+  Checkpoint() : _clauseCnt(0) {}
+
+  void addClause(Clause* cl, bool active);
+  void addClause(CompressedClause* ccl);
+
+  void save(vstring fileName);
+
+  static void load(vstring fileName, ClauseStack& active, ClauseStack& passive);
+
+private:
+  static bool checkTerm(const unsigned*& code, const unsigned* end, unsigned functions);
+  static bool checkLiteral(const unsigned*& code, const unsigned* end,
+      unsigned functions, unsigned predicates, unsigned sorts);
+
+  /** the clause records, see addClause() */
+  Stack<unsigned> _records;
+  unsigned _clauseCnt;
+};
+
+}
+
+#endif // __Checkpoint__
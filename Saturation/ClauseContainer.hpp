@@ -120,6 +120,8 @@ public:
   Clause* pop();
   bool isEmpty() const
   { return _data.isEmpty(); }
+  ClauseIterator iterator()
+  { return pvi( Deque<Clause*>::Iterator(_data) ); }
 private:
   Deque<Clause*> _data;
 };
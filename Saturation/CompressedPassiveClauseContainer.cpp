@@ -0,0 +1,358 @@
+
+/*
+ * File CompressedPassiveClauseContainer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompressedPassiveClauseContainer.cpp
+ * Implements class CompressedPassiveClauseContainer.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/CompressedClause.hpp"
+
+#include "Inferences/InferenceEngine.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "Checkpoint.hpp"
+#include "CompressedPassiveClauseContainer.hpp"
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Inferences;
+
+int CompressedPassiveClauseContainer::s_nwcNumerator;
+int CompressedPassiveClauseContainer::s_nwcDenominator;
+
+CompressedPassiveClauseContainer::Entry::Entry(Clause* cl, const Options& opt)
+ : age(cl->age()), weight(cl->weight()), number(cl->number()),
+   inputType(cl->inputType()), goal(cl->isGoal()), clause(cl), compressed(0), recipe(0)
+{
+  if (opt.increasedNumeralWeight()) {
+    weight=weight*2+cl->getNumeralWeight();
+  }
+}
+
+CompressedPassiveClauseContainer::Entry::Entry(ClauseRecipe* recipe, unsigned serial)
+ : age(recipe->age()), weight(recipe->weight()), number(serial),
+   inputType(recipe->inputType()), goal(recipe->isGoal()), clause(0), compressed(0), recipe(recipe)
+{
+}
+
+CompressedPassiveClauseContainer::CompressedPassiveClauseContainer(const Options& opt)
+: _compress(opt.compressPassive()), _recipeCnt(0), _balance(0), _size(0), _opt(opt)
+{
+  CALL("CompressedPassiveClauseContainer::CompressedPassiveClauseContainer");
+
+  _ageRatio = _opt.ageRatio();
+  _weightRatio = _opt.weightRatio();
+  ASS_GE(_ageRatio, 0);
+  ASS_GE(_weightRatio, 0);
+  ASS(_ageRatio > 0 || _weightRatio > 0);
+
+  s_nwcNumerator = opt.nonGoalWeightCoeffitientNumerator();
+  s_nwcDenominator = opt.nonGoalWeightCoeffitientDenominator();
+}
+
+CompressedPassiveClauseContainer::~CompressedPassiveClauseContainer()
+{
+  CALL("CompressedPassiveClauseContainer::~CompressedPassiveClauseContainer");
+
+  while (_ageQueue.isNonEmpty() || _weightQueue.isNonEmpty()) {
+    Entry* e = _ageQueue.isNonEmpty() ? _ageQueue.pop() : _weightQueue.pop();
+    if (_ageRatio && _weightRatio) {
+      _weightQueue.remove(e);
+    }
+    if (e->clause) {
+      ASS(e->clause->store()==Clause::PASSIVE);
+      e->clause->setStore(Clause::NONE);
+    } else if (e->recipe) {
+      delete e->recipe;
+    } else {
+      e->compressed->destroy();
+    }
+    delete e;
+  }
+}
+
+/**
+ * Weight comparison of entries, the same as
+ * AWPassiveClauseContainer::compareWeight() on their clauses
+ */
+Comparison CompressedPassiveClauseContainer::compareWeight(Entry* e1, Entry* e2)
+{
+  if (!e1->goal && e2->goal) {
+    return Int::compare(e1->weight*s_nwcNumerator, e2->weight*s_nwcDenominator);
+  } else if (e1->goal && !e2->goal) {
+    return Int::compare(e1->weight*s_nwcDenominator, e2->weight*s_nwcNumerator);
+  }
+  return Int::compare(e1->weight, e2->weight);
+}
+
+/**
+ * Comparison by input type and number, used by both queues when
+ * age and weight are equal. Recipes come after clauses.
+ */
+Comparison CompressedPassiveClauseContainer::compareRest(Entry* e1, Entry* e2)
+{
+  if (e1->inputType != e2->inputType) {
+    return e1->inputType > e2->inputType ? LESS : GREATER;
+  }
+  if (!e1->recipe != !e2->recipe) {
+    return e1->recipe ? GREATER : LESS;
+  }
+  return Int::compare(e1->number, e2->number);
+}
+
+Comparison CompressedPassiveClauseContainer::AgeComparator::compare(Entry* e1, Entry* e2)
+{
+  if (e1->age != e2->age) {
+    return Int::compare(e1->age, e2->age);
+  }
+  Comparison res = compareWeight(e1, e2);
+  return res==EQUAL ? compareRest(e1, e2) : res;
+}
+
+Comparison CompressedPassiveClauseContainer::WeightComparator::compare(Entry* e1, Entry* e2)
+{
+  Comparison res = compareWeight(e1, e2);
+  if (res != EQUAL) {
+    return res;
+  }
+  if (e1->age != e2->age) {
+    return Int::compare(e1->age, e2->age);
+  }
+  return compareRest(e1, e2);
+}
+
+void CompressedPassiveClauseContainer::add(Clause* cl)
+{
+  CALL("CompressedPassiveClauseContainer::add");
+
+  Entry* e = new Entry(cl, _opt);
+  if (_ageRatio) {
+    _ageQueue.insert(e);
+  }
+  if (_weightRatio) {
+    _weightQueue.insert(e);
+  }
+  ALWAYS(_uncompressed.insert(cl, e));
+  if (_compress) {
+    _recent.push(cl);
+  }
+  _size++;
+  addedEvent.fire(cl);
+}
+
+/**
+ * Add a recipe of a clause, the container takes its ownership
+ */
+void CompressedPassiveClauseContainer::addRecipe(ClauseRecipe* recipe)
+{
+  CALL("CompressedPassiveClauseContainer::addRecipe");
+
+  Entry* e = new Entry(recipe, _recipeCnt++);
+  if (_ageRatio) {
+    _ageQueue.insert(e);
+  }
+  if (_weightRatio) {
+    _weightQueue.insert(e);
+  }
+  _size++;
+}
+
+/**
+ * Remove a clause that is not compressed from the container.
+ * Clauses that can be removed other than by selection (e.g. those
+ * depending on splitting levels) are never compressed.
+ */
+void CompressedPassiveClauseContainer::remove(Clause* cl)
+{
+  CALL("CompressedPassiveClauseContainer::remove");
+  ASS(cl->store()==Clause::PASSIVE);
+
+  Entry* e = _uncompressed.get(cl);
+  _uncompressed.remove(cl);
+  if (_ageRatio) {
+    _ageQueue.remove(e);
+  }
+  if (_weightRatio) {
+    _weightQueue.remove(e);
+  }
+  delete e;
+  _size--;
+
+  removedEvent.fire(cl);
+
+  ASS(cl->store()!=Clause::PASSIVE);
+}
+
+/**
+ * Compress the clauses added since the last selection
+ */
+void CompressedPassiveClauseContainer::compressRecent()
+{
+  CALL("CompressedPassiveClauseContainer::compressRecent");
+
+  while (_recent.isNonEmpty()) {
+    Clause* cl = _recent.pop();
+    Entry* e;
+    if (!_uncompressed.find(cl, e) || !CompressedClause::canCompress(cl)) {
+      //removed, or selected already
+      continue;
+    }
+    ASS_EQ(cl->store(), Clause::PASSIVE);
+    e->compressed = CompressedClause::compress(cl);
+    if (e->compressed) {
+      _uncompressed.remove(cl);
+      e->clause = 0;
+    }
+  }
+}
+
+/**
+ * Remove the entry to be selected next from the queues
+ */
+CompressedPassiveClauseContainer::Entry* CompressedPassiveClauseContainer::popEntry()
+{
+  CALL("CompressedPassiveClauseContainer::popEntry");
+  ASS( ! isEmpty());
+
+  _size--;
+
+  bool byWeight;
+  if (! _ageRatio) {
+    byWeight = true;
+  }
+  else if (! _weightRatio) {
+    byWeight = false;
+  }
+  else if (_balance > 0) {
+    byWeight = true;
+  }
+  else if (_balance < 0) {
+    byWeight = false;
+  }
+  else {
+    byWeight = (_ageRatio <= _weightRatio);
+  }
+
+  Entry* e;
+  if (byWeight) {
+    _balance -= _ageRatio;
+    e = _weightQueue.pop();
+    if (_ageRatio) {
+      _ageQueue.remove(e);
+    }
+  } else {
+    _balance += _weightRatio;
+    e = _ageQueue.pop();
+    if (_weightRatio) {
+      _weightQueue.remove(e);
+    }
+  }
+  return e;
+}
+
+/**
+ * Select a clause. If a recipe is selected, the built clause is returned
+ * with the NONE store and no selectedEvent is fired. Recipes with a premise
+ * that is no longer active are dropped, and zero is returned if the
+ * container runs out of entries this way.
+ */
+Clause* CompressedPassiveClauseContainer::popSelected()
+{
+  CALL("CompressedPassiveClauseContainer::popSelected");
+  ASS( ! isEmpty());
+
+  while (!isEmpty()) {
+    Entry* e = popEntry();
+    if (e->recipe) {
+      ClauseRecipe* recipe = e->recipe;
+      delete e;
+      Clause* cl = 0;
+      if (recipe->premisesActive()) {
+        cl = recipe->materialise();
+      } else {
+        env.statistics->droppedDeferredInferences++;
+      }
+      delete recipe;
+      if (cl) {
+        compressRecent();
+        return cl;
+      }
+      continue;
+    }
+
+    Clause* cl;
+    if (e->clause) {
+      cl = e->clause;
+      _uncompressed.remove(cl);
+    } else {
+      cl = e->compressed->decompress();
+      cl->setStore(Clause::PASSIVE);
+      ASS_EQ(cl->number(), e->number);
+    }
+    delete e;
+
+    compressRecent();
+
+    selectedEvent.fire(cl);
+    return cl;
+  }
+  compressRecent();
+  return 0;
+}
+
+/**
+ * Return iterator over the clauses that are not compressed
+ */
+ClauseIterator CompressedPassiveClauseContainer::iterator()
+{
+  return _uncompressed.domain();
+}
+
+/**
+ * Add the passive clauses to the checkpoint @b cp, compressed ones
+ * without rebuilding them. There are no recipes, as lazy_generation
+ * cannot be used with checkpoints.
+ */
+void CompressedPassiveClauseContainer::addToCheckpoint(Checkpoint& cp)
+{
+  CALL("CompressedPassiveClauseContainer::addToCheckpoint");
+
+  SkipList<Entry*,AgeComparator>::Iterator ait(_ageQueue);
+  SkipList<Entry*,WeightComparator>::Iterator wit(_weightQueue);
+  while (_ageRatio ? ait.hasNext() : wit.hasNext()) {
+    Entry* e = _ageRatio ? ait.next() : wit.next();
+    ASS(!e->recipe);
+    if (e->clause) {
+      cp.addClause(e->clause, false);
+    } else {
+      cp.addClause(e->compressed);
+    }
+  }
+}
+
+}
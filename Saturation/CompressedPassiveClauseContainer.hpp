@@ -0,0 +1,153 @@
+
+/*
+ * File CompressedPassiveClauseContainer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompressedPassiveClauseContainer.hpp
+ * Defines the class CompressedPassiveClauseContainer
+ */
+
+#ifndef __CompressedPassiveClauseContainer__
+#define __CompressedPassiveClauseContainer__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Comparison.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/SkipList.hpp"
+#include "Lib/Stack.hpp"
+
+#include "ClauseContainer.hpp"
+
+namespace Saturation {
+
+using namespace Kernel;
+
+/**
+ * Passive clause container with the age-weight selection of
+ * AWPassiveClauseContainer, which keeps clauses as CompressedClause
+ * objects and rebuilds a clause only when it is selected.
+ *
+ * Clauses are compressed when the next clause is selected, as until
+ * then the saturation algorithm may still refer to them. Clauses that
+ * cannot be compressed (see CompressedClause::canCompress()) are kept
+ * as they are. Only the keys of the selection order are kept outside
+ * the compressed code.
+ *
+ * The container is meant for saturation algorithms that do not use
+ * passive clauses for simplification (i.e. Discount), as compressed
+ * clauses are in no index.
+ *
+ * With the lazy_generation option the container also keeps recipes
+ * of generating inferences (see ClauseRecipe), whose conclusions are
+ * built when the recipe is selected. Such a conclusion is returned by
+ * popSelected() as a new clause that was never passive.
+ */
+class CompressedPassiveClauseContainer
+: public PassiveClauseContainer
+{
+public:
+  CLASS_NAME(CompressedPassiveClauseContainer);
+  USE_ALLOCATOR(CompressedPassiveClauseContainer);
+
+  CompressedPassiveClauseContainer(const Options& opt);
+  virtual ~CompressedPassiveClauseContainer();
+
+  void add(Clause* cl);
+  void addRecipe(Inferences::ClauseRecipe* recipe);
+  void remove(Clause* cl);
+  Clause* popSelected();
+
+  /** True if there are no passive clauses */
+  bool isEmpty() const { return !_size; }
+
+  ClauseIterator iterator();
+
+  void addToCheckpoint(Checkpoint& cp);
+
+  unsigned size() const { return _size; }
+
+private:
+  /**
+   * A passive clause, either a Clause object or a compressed one,
+   * or a recipe of a clause
+   */
+  struct Entry
+  {
+    CLASS_NAME(CompressedPassiveClauseContainer::Entry);
+    USE_ALLOCATOR(Entry);
+
+    Entry(Clause* cl, const Options& opt);
+    Entry(Inferences::ClauseRecipe* recipe, unsigned serial);
+
+    unsigned age;
+    /** weight as used by AWPassiveClauseContainer::compareWeight */
+    unsigned weight;
+    /** clause number, or the serial number of a recipe */
+    unsigned number;
+    unsigned inputType : 3;
+    unsigned goal : 1;
+
+    /** zero if the clause is compressed or if this is a recipe */
+    Clause* clause;
+    CompressedClause* compressed;
+    Inferences::ClauseRecipe* recipe;
+  };
+
+  static Comparison compareWeight(Entry* e1, Entry* e2);
+  static Comparison compareRest(Entry* e1, Entry* e2);
+
+  struct AgeComparator
+  {
+    static Comparison compare(Entry* e1, Entry* e2);
+  };
+  struct WeightComparator
+  {
+    static Comparison compare(Entry* e1, Entry* e2);
+  };
+
+  void compressRecent();
+  Entry* popEntry();
+
+  /** non-goal weight coefficient, the comparators are static */
+  static int s_nwcNumerator;
+  static int s_nwcDenominator;
+
+  SkipList<Entry*,AgeComparator> _ageQueue;
+  SkipList<Entry*,WeightComparator> _weightQueue;
+  /** Entries of clauses that are not compressed */
+  DHMap<Clause*,Entry*> _uncompressed;
+  /** Clauses added since the last selection */
+  Stack<Clause*> _recent;
+  /** passive clauses are compressed (the compress_passive option) */
+  bool _compress;
+  unsigned _recipeCnt;
+
+  int _ageRatio;
+  int _weightRatio;
+  /** current balance. If &lt;0 then selection by age, if &gt;0
+   * then by weight */
+  int _balance;
+  unsigned _size;
+
+  const Options& _opt;
+};
+
+}
+
+#endif /* __CompressedPassiveClauseContainer__ */
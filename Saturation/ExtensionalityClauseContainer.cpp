@@ -151,6 +151,10 @@ struct ExtensionalityClauseContainer::ActiveFilterFn
       _parent._size--;
       return false;
     }
+    if (extCl.clause->isDormant()) {
+      // stays in the list, it may become active again
+      return false;
+    }
     return true;
   }
 private:
@@ -21,6 +21,9 @@
  * Implements class LRS.
  */
 
+#include "Debug/RuntimeStatistics.hpp"
+
+#include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/TimeCounter.hpp"
@@ -39,6 +42,14 @@ using namespace Lib;
 using namespace Kernel;
 using namespace Shell;
 
+void LRS::init()
+{
+  CALL("LRS::init");
+
+  SaturationAlgorithm::init();
+  _startMemory=Allocator::getUsedMemory();
+}
+
 bool LRS::isComplete()
 {
   CALL("LRS::isComplete");
@@ -91,13 +102,35 @@ bool LRS::shouldUpdateLimits()
 
 /**
  * Resturn an estimate of the number of clauses that the saturation
- * algorithm will be able to activate in the remaining time
+ * algorithm will be able to activate in the remaining time and memory,
+ * or -1 if there is no estimate yet
  */
 long long LRS::estimatedReachableCount()
 {
   CALL("LRS::estimatedReachableCount");
 
   long long processed=env.statistics->activeClauses;
+  if(processed<=10) {
+    return -1;
+  }
+
+  long long timeReachable=timeReachableCount(processed);
+  long long memoryReachable=memoryReachableCount(processed);
+  if(memoryReachable>=0 && (timeReachable<0 || memoryReachable<timeReachable)) {
+    RSTAT_CTR_INC("lrs estimates bounded by memory");
+    return memoryReachable;
+  }
+  return timeReachable;
+}
+
+/**
+ * Return an estimate of the number of clauses that can be activated
+ * in the remaining time, or -1 if there is none
+ */
+long long LRS::timeReachableCount(long long processed)
+{
+  CALL("LRS::timeReachableCount");
+
   int currTime=env.timer->elapsedMilliseconds();
   long long timeSpent=currTime-_startTime;
   //the result is in miliseconds, as _opt.lrsFirstTimeCheck() is in percents.
@@ -114,11 +147,47 @@ long long LRS::estimatedReachableCount()
   } else {
     timeLeft=_opt.timeLimitInDeciseconds()*100 - currTime;
   }
-  if(timeLeft<=0 || processed<=10) {
+  if(timeLeft<=0) {
     //we end-up here even if there is no time limit (i.e. time limit is set to 0)
     return -1;
   }
   return (processed*timeLeft)/timeSpent;
 }
 
+/**
+ * Return an estimate of the number of clauses that can be activated
+ * before the used memory reaches the lrs_memory_budget percentage of
+ * the memory limit, or -1 if there is none. There is no estimate
+ * until half of that memory is used.
+ *
+ * Memory is assumed to grow linearly with the number of activations,
+ * as most of it is taken by the clauses these generate into passive.
+ * When the estimate is smaller than the passive size, the limits set
+ * from it make the passive container discard the clauses above them,
+ * which frees the memory they take.
+ */
+long long LRS::memoryReachableCount(long long processed)
+{
+  CALL("LRS::memoryReachableCount");
+
+  unsigned budgetPercentage=_opt.lrsMemoryBudget();
+  if(!budgetPercentage) {
+    return -1;
+  }
+
+  size_t used=Allocator::getUsedMemory();
+  size_t budget=(Allocator::getMemoryLimit()/100)*budgetPercentage;
+  if(used>=budget) {
+    return 0;
+  }
+  if(used*2<budget || used<=_startMemory) {
+    //early growth is dominated by the indexing and term sharing
+    //structures and does not extrapolate well
+    return -1;
+  }
+  long long growth=used-_startMemory;
+  long long memoryLeft=budget-used;
+  return (processed*memoryLeft)/growth;
+}
+
 }
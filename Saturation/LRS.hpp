@@ -43,11 +43,14 @@ public:
   USE_ALLOCATOR(LRS);
 
   LRS(Problem& prb, const Options& opt)
-  : Otter(prb, opt), _limitsEverActive(false) {}
+  : Otter(prb, opt), _limitsEverActive(false), _startMemory(0) {}
 
 
 protected:
 
+  //overrides SaturationAlgorithm::init
+  void init();
+
   //overrides SaturationAlgorithm::isComplete
   bool isComplete();
 
@@ -57,8 +60,12 @@ protected:
   bool shouldUpdateLimits();
 
   long long estimatedReachableCount();
+  long long timeReachableCount(long long processed);
+  long long memoryReachableCount(long long processed);
 
   bool _limitsEverActive;
+  /** Memory used when the saturation started */
+  size_t _startMemory;
 };
 
 };
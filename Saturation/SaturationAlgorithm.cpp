@@ -23,6 +23,7 @@
 
 #include "Debug/RuntimeStatistics.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Metaiterators.hpp"
@@ -33,6 +34,7 @@
 #include "Lib/System.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/ColorHelper.hpp"
@@ -44,6 +46,7 @@
 #include "Kernel/LiteralSelector.hpp"
 #include "Kernel/MLVariant.hpp"
 #include "Kernel/Problem.hpp"
+#include "Kernel/ProofLog.hpp"
 #include "Kernel/SubformulaIterator.hpp"
 #include "Kernel/Unit.hpp"
 
@@ -76,6 +79,7 @@
 #include "Shell/AnswerExtractor.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
+#include "Shell/StatisticsStream.hpp"
 #include "Shell/UIHelper.hpp"
 
 #include "Splitter.hpp"
@@ -86,6 +90,8 @@
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
 #include "AWPassiveClauseContainer.hpp"
+#include "Checkpoint.hpp"
+#include "CompressedPassiveClauseContainer.hpp"
 #include "Discount.hpp"
 #include "LRS.hpp"
 #include "Otter.hpp"
@@ -115,6 +121,9 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   : MainLoop(prb, opt),
     _limits(opt),
     _clauseActivationInProgress(false),
+    _clauseInProgress(0),
+    _termCollectionMemory(0),
+    _proofCompactionCountdown(0),
     _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0),
     _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
     _instantiation(0),
@@ -139,7 +148,15 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   _completeOptionSettings = opt.complete(prb);
 
   _unprocessed = new UnprocessedClauseContainer();
-  _passive = new AWPassiveClauseContainer(opt);
+  _lazyGeneration = opt.lazyGeneration() && opt.saturationAlgorithm()==Options::SaturationAlgorithm::DISCOUNT;
+  if ((opt.compressPassive() || opt.lazyGeneration()) &&
+      opt.saturationAlgorithm()==Options::SaturationAlgorithm::DISCOUNT) {
+    _compressedPassive = new CompressedPassiveClauseContainer(opt);
+    _passive = _compressedPassive;
+  } else {
+    _compressedPassive = 0;
+    _passive = new AWPassiveClauseContainer(opt);
+  }
   _active = new ActiveClauseContainer(opt);
 
   _active->attach(this);
@@ -242,7 +259,9 @@ ClauseIterator SaturationAlgorithm::activeClauses()
   CALL("SaturationAlgorithm::activeClauses");
 
   LiteralIndexingStructure* gis=getIndexManager()->getGeneratingLiteralIndexingStructure();
-  return pvi( getMappingIterator(gis->getAll(), SLQueryResult::ClauseExtractFn()) );
+  return pvi( getMappingIterator(
+      getFilteredIterator(gis->getAll(), SLQueryResult::NonDormantFn()),
+      SLQueryResult::ClauseExtractFn()) );
 }
 
 ClauseIterator SaturationAlgorithm::passiveClauses()
@@ -654,6 +673,10 @@ void SaturationAlgorithm::init()
 {
   CALL("SaturationAlgorithm::init");
 
+  if (!_opt.resumeFile().empty()) {
+    loadCheckpoint();
+  }
+
   ClauseIterator toAdd = _prb.clauseIterator();
 
   while (toAdd.hasNext()) {
@@ -672,6 +695,126 @@ void SaturationAlgorithm::init()
   }
 
   _startTime=env.timer->elapsedMilliseconds();
+
+  if (_opt.termCollection()) {
+    // terms created so far are kept for good
+    env.sharing->enableCollection();
+    _termCollectionMemory=(Allocator::getMemoryLimit()/100)*_opt.termCollection();
+  }
+  if (_opt.proofCompaction()) {
+    ProofLog::instance()->enable();
+    _proofCompactionCountdown=_opt.proofCompaction();
+  }
+}
+
+/**
+ * Destroy the shared terms not used by any live unit, see TermSharing::collect().
+ * This is done between the steps of the saturation loop, when no inference
+ * holds terms that are not in any unit yet.
+ *
+ * The memory of the destroyed terms is reused by the allocator rather than
+ * given back, so the used memory does not decrease. The next collection
+ * happens when half of the memory remaining up to the limit is used.
+ */
+void SaturationAlgorithm::collectTerms()
+{
+  CALL("SaturationAlgorithm::collectTerms");
+
+  env.statistics->collectedTerms+=env.sharing->collect();
+  env.statistics->termCollections++;
+
+  size_t used=Allocator::getUsedMemory();
+  size_t limit=Allocator::getMemoryLimit();
+  size_t next=used<limit ? used+(limit-used)/2 : limit;
+  _termCollectionMemory=max(next, (limit/100)*_opt.termCollection());
+}
+
+/**
+ * Move the derivations of the clauses to the proof log and drop the records
+ * no longer needed, see ProofLog::compact(). As for collectTerms(), this
+ * is done between the steps of the saturation loop.
+ */
+void SaturationAlgorithm::compactProofs()
+{
+  CALL("SaturationAlgorithm::compactProofs");
+
+  ProofLog::instance()->compact();
+  env.statistics->proofCompactions++;
+  env.statistics->proofLogRecords=ProofLog::instance()->size();
+  _proofCompactionCountdown=_opt.proofCompaction();
+}
+
+/**
+ * Continue the proof search saved in the checkpoint file given by the
+ * resume_file option. Clauses that were active are put directly into
+ * the active container, as the generating inferences among them have
+ * been performed already, the other ones are added as new clauses.
+ */
+void SaturationAlgorithm::loadCheckpoint()
+{
+  CALL("SaturationAlgorithm::loadCheckpoint");
+
+  ClauseStack active;
+  ClauseStack passive;
+  Checkpoint::load(_opt.resumeFile(), active, passive);
+
+  while (active.isNonEmpty()) {
+    Clause* cl = active.pop();
+    //an extra reference, as in addInputSOSClause
+    cl->incRefCnt();
+    onNewClause(cl);
+    _selector->select(cl);
+    cl->setStore(Clause::ACTIVE);
+    env.statistics->activeClauses++;
+    _active->add(cl);
+    cl->decRefCnt();
+  }
+  while (passive.isNonEmpty()) {
+    addNewClause(passive.pop());
+  }
+}
+
+/**
+ * Save the clauses of the proof search to the checkpoint file given by
+ * the checkpoint_file option. Unprocessed and new clauses are saved
+ * as passive, and so is the clause whose processing was interrupted.
+ */
+void SaturationAlgorithm::saveCheckpoint()
+{
+  CALL("SaturationAlgorithm::saveCheckpoint");
+
+  Checkpoint cp;
+
+  //a clause is in the index once for each of its selected literals
+  DHSet<Clause*> seen;
+  ClauseIterator ait = activeClauses();
+  while (ait.hasNext()) {
+    Clause* cl = ait.next();
+    if (cl != _clauseInProgress && seen.insert(cl)) {
+      cp.addClause(cl, true);
+    }
+  }
+  if (_compressedPassive) {
+    _compressedPassive->addToCheckpoint(cp);
+  } else {
+    ClauseIterator pit = passiveClauses();
+    while (pit.hasNext()) {
+      cp.addClause(pit.next(), false);
+    }
+  }
+  ClauseIterator uit = _unprocessed->iterator();
+  while (uit.hasNext()) {
+    cp.addClause(uit.next(), false);
+  }
+  RCClauseStack::Iterator nit(_newClauses);
+  while (nit.hasNext()) {
+    cp.addClause(nit.next(), false);
+  }
+  if (_clauseInProgress && _clauseInProgress->store() != Clause::PASSIVE) {
+    cp.addClause(_clauseInProgress, false);
+  }
+
+  cp.save(_opt.checkpointFile());
 }
 
 Clause* SaturationAlgorithm::doImmediateSimplification(Clause* cl0)
@@ -988,6 +1131,38 @@ void SaturationAlgorithm::addToPassive(Clause* cl)
  * function are postponed. During the clause activation, generalisation
  * indexes should not be modified.
  */
+/**
+ * Add a clause derived by a generating inference and report
+ * its premises as its parents
+ */
+void SaturationAlgorithm::addGeneratedClause(Clause* genCl)
+{
+  CALL("SaturationAlgorithm::addGeneratedClause");
+
+  addNewClause(genCl);
+
+  Inference::Iterator iit=genCl->inference()->iterator();
+  while (genCl->inference()->hasNext(iit)) {
+    Unit* premUnit=genCl->inference()->next(iit);
+    ASS(premUnit->isClause());
+    Clause* premCl=static_cast<Clause*>(premUnit);
+
+    onParenthood(genCl, premCl);
+  }
+}
+
+/**
+ * Put a recipe of a generated clause to the passive container
+ * instead of the clause (see the lazy_generation option)
+ */
+void SaturationAlgorithm::addNewRecipe(ClauseRecipe* recipe)
+{
+  CALL("SaturationAlgorithm::addNewRecipe");
+  ASS(_lazyGeneration);
+
+  _compressedPassive->addRecipe(recipe);
+}
+
 bool SaturationAlgorithm::activate(Clause* cl)
 {
   CALL("SaturationAlgorithm::activate");
@@ -1031,18 +1206,7 @@ bool SaturationAlgorithm::activate(Clause* cl)
     ClauseIterator toAdd= pvi(getConcatenatedIterator(instances,_generator->generateClauses(cl)));
 
     while (toAdd.hasNext()) {
-      Clause* genCl=toAdd.next();
-
-      addNewClause(genCl);
-
-      Inference::Iterator iit=genCl->inference()->iterator();
-      while (genCl->inference()->hasNext(iit)) {
-        Unit* premUnit=genCl->inference()->next(iit);
-        ASS(premUnit->isClause());
-        Clause* premCl=static_cast<Clause*>(premUnit);
-
-        onParenthood(genCl, premCl);
-      }
+      addGeneratedClause(toAdd.next());
     }
 
   _clauseActivationInProgress=false;
@@ -1076,6 +1240,7 @@ start:
     Clause* c = _unprocessed->pop();
     ASS(!isRefutation(c));
 
+    _clauseInProgress = c;
     if (forwardSimplify(c)) {
       onClauseRetained(c);
       addToPassive(c);
@@ -1085,6 +1250,7 @@ start:
       ASS_EQ(c->store(), Clause::UNPROCESSED);
       c->setStore(Clause::NONE);
     }
+    _clauseInProgress = 0;
 
     newClausesToUnprocessed();
 
@@ -1144,6 +1310,9 @@ UnitList* SaturationAlgorithm::collectSaturatedSet()
   SLQueryResultIterator qrit = gis->getAll();
   while (qrit.hasNext()) {
     SLQueryResult qres = qrit.next();
+    if (qres.clause->isDormant()) {
+      continue;
+    }
     UnitList::push(qres.clause, res);
     qres.clause->incRefCnt();
   }
@@ -1158,6 +1327,14 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  if (_proofCompactionCountdown && !--_proofCompactionCountdown) {
+    //before collecting terms, as it releases clauses
+    compactProofs();
+  }
+  if (_termCollectionMemory && Allocator::getUsedMemory()>_termCollectionMemory) {
+    collectTerms();
+  }
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
@@ -1180,6 +1357,17 @@ void SaturationAlgorithm::doOneAlgorithmStep()
   }
 
   Clause* cl = _passive->popSelected();
+  if (_lazyGeneration) {
+    if (!cl) {
+      //only recipes with inactive premises were left
+      return;
+    }
+    if (cl->store()==Clause::NONE) {
+      //conclusion of a recipe, it goes through forward simplification first
+      addGeneratedClause(cl);
+      return;
+    }
+  }
   ASS_EQ(cl->store(),Clause::PASSIVE);
   cl->setStore(Clause::SELECTED);
 
@@ -1187,10 +1375,12 @@ void SaturationAlgorithm::doOneAlgorithmStep()
     return;
   }
 
+  _clauseInProgress=cl;
   bool isActivated=activate(cl);
   if (!isActivated) {
     handleUnsuccessfulActivation(cl);
   }
+  _clauseInProgress=0;
 }
 
 
@@ -1202,6 +1392,12 @@ MainLoopResult SaturationAlgorithm::runImpl()
 {
   CALL("SaturationAlgorithm::runImpl");
 
+  if (!_opt.checkpointFile().empty()) {
+    //the time limit must be met by an exception reaching this function,
+    //where the clauses can be saved
+    Timer::setTimeLimitEnforcement(false);
+  }
+
   unsigned l = 0;
   try
   {
@@ -1216,8 +1412,17 @@ MainLoopResult SaturationAlgorithm::runImpl()
       if (env.timeLimitReached()) {
         throw TimeLimitExceededException();
       }
+      StatisticsStream::tick();
     }
   }
+  catch(TimeLimitExceededException&)
+  {
+    if (!_opt.checkpointFile().empty()) {
+      saveCheckpoint();
+    }
+    tryUpdateFinalClauseCount();
+    throw;
+  }
   catch(ThrowableBase&)
   {
     tryUpdateFinalClauseCount();
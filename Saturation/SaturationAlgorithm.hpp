@@ -89,8 +89,12 @@ public:
 
 
   void addNewClause(Clause* cl);
+  void addNewRecipe(ClauseRecipe* recipe);
   bool clausesFlushed();
 
+  /** True if generating inferences pass recipes by addNewRecipe() instead of clauses */
+  bool lazyGeneration() const { return _lazyGeneration; }
+
   void removeActiveOrPassiveClause(Clause* cl);
 
   void onClauseReduction(Clause* cl, Clause* replacement, Clause* premise, bool forward=true);
@@ -146,6 +150,7 @@ protected:
   bool forwardSimplify(Clause* c);
   void backwardSimplify(Clause* c);
   void addToPassive(Clause* c);
+  void addGeneratedClause(Clause* genCl);
   bool activate(Clause* c);
   virtual void onSOSClauseAdded(Clause* c) {}
   void onActiveAdded(Clause* c);
@@ -169,6 +174,12 @@ private:
 
   LiteralSelector& getSosLiteralSelector();
 
+  void loadCheckpoint();
+  void saveCheckpoint();
+
+  void collectTerms();
+  void compactProofs();
+
   void handleEmptyClause(Clause* cl);
   Clause* doImmediateSimplification(Clause* cl);
   MainLoopResult saturateImpl();
@@ -184,6 +195,17 @@ protected:
   bool _completeOptionSettings;
   int _startTime;
   bool _clauseActivationInProgress;
+  /**
+   * The clause being forward simplified or activated, which a checkpoint
+   * saved when the step is interrupted must keep as passive
+   */
+  Clause* _clauseInProgress;
+  /** the passive container is a CompressedPassiveClauseContainer taking recipes */
+  bool _lazyGeneration;
+  /** used memory above which unused shared terms are collected, zero if they are never */
+  size_t _termCollectionMemory;
+  /** iterations of the saturation loop until the proof log is compacted, zero if it is never */
+  unsigned _proofCompactionCountdown;
 
   RCClauseStack _newClauses;
 
@@ -191,6 +213,8 @@ protected:
 
   UnprocessedClauseContainer* _unprocessed;
   PassiveClauseContainer* _passive;
+  /** @b _passive if it is a CompressedPassiveClauseContainer, otherwise zero */
+  CompressedPassiveClauseContainer* _compressedPassive;
   ActiveClauseContainer* _active;
   ExtensionalityClauseContainer* _extensionality;
 
@@ -54,6 +54,7 @@
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
+#include "DP/LinearArithmeticDP.hpp"
 #include "DP/ShortConflictMetaDP.hpp"
 
 #include "SaturationAlgorithm.hpp"
@@ -75,6 +76,7 @@ void SplittingBranchSelector::init()
 
   _eagerRemoval = _parent.getOptions().splittingEagerRemoval();
   _literalPolarityAdvice = _parent.getOptions().splittingLiteralPolarityAdvice();
+  _asyncModelBudget = _parent.getOptions().splittingAsyncModelBudget();
 
   switch(_parent.getOptions().satSolver()){
     case Options::SatSolver::VAMPIRE:  
@@ -117,7 +119,7 @@ void SplittingBranchSelector::init()
   _minSCO = _parent.getOptions().splittingMinimizeModel() == Options::SplittingMinimizeModel::SCO;
 
   if(_parent.getOptions().splittingCongruenceClosure() != Options::SplittingCongruenceClosure::OFF) {
-    _dp = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
+    _dp = new DP::SimpleCongruenceClosure(&_parent.getOrdering(), _parent.getOptions().ccIncremental());
     if (_parent.getOptions().ccUnsatCores() == Options::CCUnsatCores::SMALL_ONES) {
       _dp = new ShortConflictMetaDP(_dp.release(), _parent.satNaming(), *_solver);
     }
@@ -128,6 +130,10 @@ void SplittingBranchSelector::init()
       _dpModel = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
     }
   }
+
+  if(_parent.getOptions().avatarArithmetic()) {
+    _arithmeticDp = new ShortConflictMetaDP(new DP::LinearArithmeticDP(), _parent.satNaming(), *_solver);
+  }
 }
 
 void SplittingBranchSelector::updateVarCnt()
@@ -411,50 +417,73 @@ int SplittingBranchSelector::assertedGroundPositiveEqualityCompomentMaxAge()
   return max;
 }
 
+/**
+ * Pass the ground assignment to @b dp and add the conflict clauses
+ * for its unsat cores to the SAT solver. Return the number of clauses added.
+ */
+unsigned SplittingBranchSelector::addDPConflicts(DecisionProcedure& dp, bool multipleCores,
+    const LiteralStack& gndAssignment)
+{
+  CALL("SplittingBranchSelector::addDPConflicts");
+
+  SAT2FO& s2f = _parent.satNaming();
+  static LiteralStack unsatCore;
+
+  dp.reset();
+  dp.addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+  DecisionProcedure::Status dpStatus = dp.getStatus(multipleCores);
+
+  if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
+    return 0;
+  }
+
+  unsigned unsatCoreCnt = dp.getUnsatCoreCount();
+  for(unsigned i=0; i<unsatCoreCnt; i++) {
+    unsatCore.reset();
+    dp.getUnsatCore(unsatCore, i);
+    SATClause* conflCl = s2f.createConflictClause(unsatCore);
+    if (_minSCO) {
+      _solver->addClauseIgnoredInPartialModel(conflCl);
+    } else {
+      _solver->addClause(conflCl);
+    }
+  }
+
+  RSTAT_CTR_INC("ssat_dp_conflict");
+  RSTAT_CTR_INC_MANY("ssat_dp_conflict_clauses",unsatCoreCnt);
+  return unsatCoreCnt;
+}
+
 SATSolver::Status SplittingBranchSelector::processDPConflicts()
 {
   CALL("SplittingBranchSelector::processDPConflicts");
   // ASS(_solver->getStatus()==SATSolver::SATISFIABLE);
 
-  if(!_dp) {
+  if(!_dp && !_arithmeticDp) {
     return SATSolver::SATISFIABLE;
   }
   
   SAT2FO& s2f = _parent.satNaming();
   static LiteralStack gndAssignment;
-  static LiteralStack unsatCore;
 
   while (true) { // breaks inside
-    {
-      TimeCounter tc(TC_CONGRUENCE_CLOSURE);
-    
-      gndAssignment.reset();
-      // collects only ground literals, because it known only about them ...
-      s2f.collectAssignment(*_solver, gndAssignment); 
-      // ... moreover, _dp->addLiterals will filter the set anyway
-
-      _dp->reset();
-      _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
-      DecisionProcedure::Status dpStatus = _dp->getStatus(_ccMultipleCores);
-
-      if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
-        break;
-      }
+    gndAssignment.reset();
+    // collects only ground literals, because it known only about them ...
+    s2f.collectAssignment(*_solver, gndAssignment); 
+    // ... moreover, addLiterals of the decision procedures will filter the set anyway
 
-      unsigned unsatCoreCnt = _dp->getUnsatCoreCount();
-      for(unsigned i=0; i<unsatCoreCnt; i++) {
-        unsatCore.reset();
-        _dp->getUnsatCore(unsatCore, i);
-        SATClause* conflCl = s2f.createConflictClause(unsatCore);
-        if (_minSCO) {
-          _solver->addClauseIgnoredInPartialModel(conflCl);
-        } else {
-          _solver->addClause(conflCl);
-        }
-      }
-
-      RSTAT_CTR_INC("ssat_dp_conflict");
-      RSTAT_CTR_INC_MANY("ssat_dp_conflict_clauses",unsatCoreCnt);
+    unsigned conflictCnt = 0;
+    if(_dp) {
+      TimeCounter tc(TC_CONGRUENCE_CLOSURE);
+      conflictCnt = addDPConflicts(*_dp, _ccMultipleCores, gndAssignment);
+    }
+    // arithmetic is checked only once the assignment is consistent as far as equality is concerned
+    if(!conflictCnt && _arithmeticDp) {
+      TimeCounter tc(TC_LINEAR_ARITHMETIC);
+      conflictCnt = addDPConflicts(*_arithmeticDp, true, gndAssignment);
+    }
+    if(!conflictCnt) {
+      break;
     }
 
     // there was conflict, so we try looking for a different model
@@ -605,22 +634,43 @@ void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRef
   }
 }
 
-void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize)
+/**
+ * Compute a new model and collect the components which should be added
+ * and removed to make the first-order part agree with it.
+ *
+ * With a non-zero avatar_async_model_budget and @b complete false,
+ * the SAT solver only gets a bounded number of conflicts. If that is not
+ * enough, false is returned, the previous model stays in place,
+ * and the search (keeping what the solver learned so far) is resumed
+ * by the next call.
+ *
+ * Return true if a new model was established.
+ */
+bool SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize, bool complete)
 {
   CALL("SplittingBranchSelector::recomputeModel");
   ASS(addedComps.isEmpty());
   ASS(removedComps.isEmpty());
 
   unsigned maxSatVar = _parent.maxSatVar();
-  
+  unsigned conflictCountLimit = (_asyncModelBudget && !complete) ? _asyncModelBudget : UINT_MAX;
+
   SATSolver::Status stat;
   {
     TimeCounter tc1(TC_SAT_SOLVER);
     if (randomize) {
       _solver->randomizeForNextAssignment(maxSatVar);
     }
-    stat = _solver->solve();
+    stat = _solver->solve(conflictCountLimit);
+  }
+  if (stat == SATSolver::UNKNOWN && conflictCountLimit != UINT_MAX) {
+    // out of budget; keep working with the old model for now
+    RSTAT_CTR_INC("ssat_postponed_models");
+    _modelPending = true;
+    return false;
   }
+  _modelPending = false;
+
   if (stat == SATSolver::SATISFIABLE) {
     stat = processDPConflicts();
   }
@@ -651,6 +701,8 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   RSTAT_CTR_INC_MANY("ssat_usual_activations", addedComps.size());
   RSTAT_CTR_INC_MANY("ssat_usual_deactivations", removedComps.size());
   */
+
+  return true;
 }
 
 //////////////
@@ -660,8 +712,8 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
 vstring Splitter::splPrefix = "";
 
 Splitter::Splitter()
-: _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _branchSelector(*this),
-  _clausesAdded(false), _haveBranchRefutation(false)
+: _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _lazyDeactivation(0), _branchSelector(*this),
+  _modelChangeCnt(0), _clausesAdded(false), _haveBranchRefutation(false)
 {
   CALL("Splitter::Splitter");
   if(env.options->proof()==Options::Proof::TPTP){
@@ -723,6 +775,7 @@ void Splitter::init(SaturationAlgorithm* sa)
 
   _fastRestart = opts.splittingFastRestart();
   _deleteDeactivated = opts.splittingDeleteDeactivated();
+  _lazyDeactivation = opts.splittingLazyDeactivation();
 
   if (opts.useHashingVariantIndex()) {
     _componentIdx = new HashingClauseVariantIndex();
@@ -804,7 +857,7 @@ void Splitter::onAllProcessed()
   }
 
   _haveBranchRefutation = false;
-  if(!_clausesAdded && !flushing) {
+  if(!_clausesAdded && !flushing && !_branchSelector.modelPending()) {
     return;
   }
   _clausesAdded = false;
@@ -815,7 +868,12 @@ void Splitter::onAllProcessed()
   toAdd.reset();
   toRemove.reset();  
 
-  _branchSelector.recomputeModel(toAdd, toRemove, flushing);
+  // when there is nothing left to saturate, the model cannot be postponed any further
+  bool complete = _sa->passiveClauseCount() == 0;
+  if (!_branchSelector.recomputeModel(toAdd, toRemove, flushing, complete)) {
+    // the fast clauses wait for the model to be finished
+    return;
+  }
   
   if (_showSplitting) { // TODO: this is just one of many ways Splitter could report about changes
     env.beginOutput();
@@ -840,6 +898,10 @@ void Splitter::onAllProcessed()
     if(toAdd.isNonEmpty()) {
       addComponents(toAdd);
     }
+    if(_lazyDeactivation) {
+      _modelChangeCnt++;
+      evictDormantClauses();
+    }
 
     // now that new activ-ness has been determined
     // we can put back the fast clauses, if any
@@ -1652,6 +1714,15 @@ void Splitter::addComponents(const SplitLevelStack& toAdd)
         cl->incNumActiveSplits();
         if (cl->getNumActiveSplits() == (int)cl->splits()->size()) {
           reactivated_cnt++;
+          if (cl->isDormant()) {
+            cl->setDormant(false);
+            _dormantSince.remove(cl);
+            if (cl->store()==Clause::ACTIVE) {
+              // never left the indices, nothing to redo
+              RSTAT_CTR_INC("dormant_clauses_reactivated");
+              continue;
+            }
+          }
           _sa->addNewClause(cl);
           //check that restored clause does not depend on inactive splits
           ASS(allSplitLevelsActive(cl->splits()));
@@ -1687,7 +1758,15 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
     while (chit.hasNext()) {
       Clause* ccl=chit.next();
       ASS(ccl->splits()->member(bl));
-      if(ccl->store()!=Clause::NONE) {
+      if(_lazyDeactivation && ccl->store()==Clause::ACTIVE && ccl->getNumActiveSplits()>NOT_WORTH_REINTRODUCING) {
+        // leave it in the indices, retrieval will skip it until it is reactivated
+        if(!ccl->isDormant()) {
+          RSTAT_CTR_INC("dormant_clauses");
+          ccl->setDormant(true);
+          ALWAYS(_dormantSince.insert(ccl,_modelChangeCnt));
+        }
+      }
+      else if(ccl->store()!=Clause::NONE) {
         _sa->removeActiveOrPassiveClause(ccl);
         ASS_EQ(ccl->store(), Clause::NONE);
       }
@@ -1740,6 +1819,44 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
   }
 }
 
+/**
+ * Physically remove the clauses that have been dormant
+ * for more than _lazyDeactivation model changes.
+ *
+ * They stay among the children of their components and are
+ * re-added through addNewClause, should all of them become active again.
+ */
+void Splitter::evictDormantClauses()
+{
+  CALL("Splitter::evictDormantClauses");
+  ASS(_sa->clausesFlushed());
+
+  static ClauseStack toEvict;
+  toEvict.reset();
+
+  DHMap<Clause*,unsigned>::Iterator dit(_dormantSince);
+  while(dit.hasNext()) {
+    Clause* cl;
+    unsigned since;
+    dit.next(cl,since);
+    if(_modelChangeCnt-since > _lazyDeactivation) {
+      toEvict.push(cl);
+    }
+  }
+
+  while(toEvict.isNonEmpty()) {
+    Clause* cl = toEvict.pop();
+    ASS(cl->isDormant());
+    _dormantSince.remove(cl);
+    cl->setDormant(false);
+    if(cl->store()!=Clause::NONE) {
+      _sa->removeActiveOrPassiveClause(cl);
+      ASS_EQ(cl->store(), Clause::NONE);
+    }
+    RSTAT_CTR_INC("dormant_clauses_evicted");
+  }
+}
+
 /**
  * Given a set of clauses (as obtained by saturation)
  * turn them into formulas capturing the semantics of splitting assertions.
@@ -65,7 +65,7 @@ class Splitter;
  */
 class SplittingBranchSelector {
 public:
-  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent)  {}
+  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _modelPending(false), _parent(parent)  {}
   ~SplittingBranchSelector(){
 #if VZ3
 {
@@ -82,12 +82,16 @@ _solver=0;
   void considerPolarityAdvice(SATLiteral lit);
 
   void addSatClauseToSolver(SATClause* cl, bool refutation);
-  void recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize = false);
+  bool recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize = false, bool complete = true);
+
+  /** true if the last model search ran out of its conflict budget and should be resumed */
+  bool modelPending() const { return _modelPending; }
 
   void flush(SplitLevelStack& addedComps, SplitLevelStack& removedComps);
 
 private:
   SATSolver::Status processDPConflicts();
+  unsigned addDPConflicts(DecisionProcedure& dp, bool multipleCores, const LiteralStack& gndAssignment);
   SATSolver::VarAssignment getSolverAssimentConsideringCCModel(unsigned var);
 
   void handleSatRefutation();
@@ -102,6 +106,9 @@ private:
   bool _ccMultipleCores;
   bool _minSCO; // minimize wrt splitting clauses only
   bool _ccModel;
+  unsigned _asyncModelBudget; // 0 for blocking model recomputation
+
+  bool _modelPending;
 
   Splitter& _parent;
 
@@ -109,6 +116,8 @@ private:
   ScopedPtr<DecisionProcedure> _dp;
   // use a separate copy of the decision procedure for ccModel computations and fill it up only with equalities
   ScopedPtr<SimpleCongruenceClosure> _dpModel;
+  // ground linear arithmetic over the assignment, see the avatar_arithmetic option
+  ScopedPtr<DecisionProcedure> _arithmeticDp;
   
   /**
    * Contains selected component names (splitlevels)
@@ -229,6 +238,7 @@ private:
 
   void addComponents(const SplitLevelStack& toAdd);
   void removeComponents(const SplitLevelStack& toRemove);
+  void evictDormantClauses();
 
   void collectDependenceLits(SplitSet* splits, SATLiteralStack& acc) const;
 
@@ -255,6 +265,7 @@ private:
   unsigned _flushPeriod;
   float _flushQuotient;
   Options::SplittingDeleteDeactivated _deleteDeactivated;
+  unsigned _lazyDeactivation;
   Options::SplittingCongruenceClosure _congruenceClosure;
 #if VZ3
   bool hasSMTSolver;
@@ -281,6 +292,15 @@ private:
   DHMap<Clause*,SplitLevel> _compNames;
 
   DHMap<SplitLevel,Unit*> _defs;
+
+  /**
+   * With lazy deactivation, the clauses left dormant in the active
+   * container, each with the number of model changes at the time
+   * it became dormant.
+   */
+  DHMap<Clause*,unsigned> _dormantSince;
+  /** Number of model changes so far */
+  unsigned _modelChangeCnt;
   
   //state variable used for flushing:  
   /** When this number of generated clauses is reached, it will cause flush */
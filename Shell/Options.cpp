@@ -317,6 +317,26 @@ void Options::Options::init()
     _lookup.insert(&_statistics);
     _statistics.tag(OptionTag::OUTPUT);
 
+    _statsStream = StringOptionValue("stats_stream","","");
+    _statsStream.description="File to which snapshots of the statistics, the memory used and the numbers of active "
+      "and passive clauses are appended as JSON lines while the problem is being solved. An open file descriptor "
+      "can be given as /dev/fd/N. In portfolio modes all slices write into the file, and lines marking the start "
+      "and the end of each slice are added.";
+    _lookup.insert(&_statsStream);
+    _statsStream.tag(OptionTag::OUTPUT);
+
+    _statsStreamInterval = UnsignedOptionValue("stats_stream_interval","",1000);
+    _statsStreamInterval.description="Milliseconds between the snapshots written to stats_stream during "
+      "saturation. If 0, only a snapshot at the end of each process is written.";
+    _lookup.insert(&_statsStreamInterval);
+    _statsStreamInterval.tag(OptionTag::OUTPUT);
+
+    _indexTrace = StringOptionValue("index_trace","","");
+    _indexTrace.description="File into which the operations performed on the term and literal indices are "
+      "recorded, so that they can be replayed by vindexreplay. In portfolio modes each slice overwrites the file.";
+    _lookup.insert(&_indexTrace);
+    _indexTrace.tag(OptionTag::OUTPUT);
+
     _testId = StringOptionValue("test_id","","unspecified_test");
     _testId.description="";
     _lookup.insert(&_testId);
@@ -341,6 +361,21 @@ void Options::Options::init()
     _lookup.insert(&_timeStatistics);
     _timeStatistics.tag(OptionTag::OUTPUT);
 
+    _timeProfile = StringOptionValue("time_profile","","");
+    _timeProfile.description="File to which the processor cycles spent in each nesting of the time statistics "
+      "units are written, in the collapsed stack format of flame graph tools. The nestings are also listed "
+      "with their call counts by time_statistics.";
+    _lookup.insert(&_timeProfile);
+    _timeProfile.tag(OptionTag::OUTPUT);
+
+    _hardwareCounters = BoolOptionValue("hardware_counters","hwc",false);
+    _hardwareCounters.description="Count processor cycles, instructions, cache misses, branch misses and page faults "
+      "in the outermost parts of Vampire measured by time_statistics, including the parts nested in them, and "
+      "show them as key=value pairs after the time statistics. Uses the perf_event_open system call of Linux; the events that the machine or the kernel "
+      "settings do not allow are left out.";
+    _lookup.insert(&_hardwareCounters);
+    _hardwareCounters.tag(OptionTag::OUTPUT);
+
 //*********************** Input  ***********************
 
     _include = StringOptionValue("include","","");
@@ -838,6 +873,63 @@ void Options::Options::init()
     _ageWeightRatio.reliesOn(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN))->Or<int>(_instGenWithResolution.is(equal(true))));
     _ageWeightRatio.setRandomChoices({"8:1","5:1","4:1","3:1","2:1","3:2","5:4","1","2:3","2","3","4","5","6","7","8","10","12","14","16","20","24","28","32","40","50","64","128","1024"});
 
+    _compressPassive = BoolOptionValue("compress_passive","cps",false);
+    _compressPassive.description=
+    "Keep passive clauses in a compact encoding and rebuild each of them only when it is selected. "
+    "Only clauses that depend on no splitting decisions and are not referenced by other clauses are compressed.";
+    _lookup.insert(&_compressPassive);
+    _compressPassive.tag(OptionTag::SATURATION);
+    _compressPassive.setExperimental();
+    _compressPassive.reliesOn(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
+
+    _lazyGeneration = BoolOptionValue("lazy_generation","lg",false);
+    _lazyGeneration.description=
+    "Store superpositions and binary resolutions in passive as the premises, positions and an estimated weight of the conclusion, "
+    "and build the conclusion only when it is selected. It is then simplified and added to passive as any new clause. "
+    "Inferences with a premise that is no longer active are dropped.";
+    _lookup.insert(&_lazyGeneration);
+    _lazyGeneration.tag(OptionTag::SATURATION);
+    _lazyGeneration.setExperimental();
+    _lazyGeneration.reliesOn(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
+
+    _checkpointFile = StringOptionValue("checkpoint_file","","");
+    _checkpointFile.description=
+    "When the time limit is reached, save the active and passive clauses to this file, so that the proof search "
+    "can be continued by a later run with the resume_file option. The time limit is then checked only between "
+    "steps of the saturation loop.";
+    _lookup.insert(&_checkpointFile);
+    _checkpointFile.tag(OptionTag::SATURATION);
+    _checkpointFile.setExperimental();
+    // recipes of lazy_generation refer to positions in their premises, which are not saved
+    _lazyGeneration.addHardConstraint(If(equal(true)).then(_checkpointFile.is(equal(vstring("")))));
+
+    _resumeFile = StringOptionValue("resume_file","","");
+    _resumeFile.description=
+    "Continue the proof search saved by a run with the checkpoint_file option. The problem and the options "
+    "affecting preprocessing must be the same as in that run.";
+    _lookup.insert(&_resumeFile);
+    _resumeFile.tag(OptionTag::SATURATION);
+    _resumeFile.setExperimental();
+
+    _termCollection = UnsignedOptionValue("term_collection","tcl",0);
+    _termCollection.description=
+    "Percentage of the memory limit above which the shared terms and literals created during the proof search "
+    "that are no longer contained in any clause or formula are destroyed. Afterwards, the next collection happens "
+    "when half of the remaining memory is used. If 0, terms are never destroyed.";
+    _lookup.insert(&_termCollection);
+    _termCollection.tag(OptionTag::SATURATION);
+    _termCollection.setExperimental();
+    _termCollection.addConstraint(lessThanEq(100u));
+
+    _proofCompaction = UnsignedOptionValue("proof_compaction","prc",0);
+    _proofCompaction.description=
+    "If not 0, every this many iterations of the saturation loop the derivations of the clauses are moved "
+    "to a compact log, so that the clauses deleted from the search are not kept by the inferences of their "
+    "descendants, and the records of the log no longer needed are removed. The proof is rebuilt from the log.";
+    _lookup.insert(&_proofCompaction);
+    _proofCompaction.tag(OptionTag::SATURATION);
+    _proofCompaction.setExperimental();
+
 	    _literalMaximalityAftercheck = BoolOptionValue("literal_maximality_aftercheck","lma",false);
 	    _lookup.insert(&_literalMaximalityAftercheck);
 	    _literalMaximalityAftercheck.tag(OptionTag::SATURATION);
@@ -851,6 +943,13 @@ void Options::Options::init()
 	    _lrsFirstTimeCheck.addConstraint(greaterThanEq(0));
 	    _lrsFirstTimeCheck.addConstraint(lessThan(100));
 
+	    _lrsMemoryBudget = UnsignedOptionValue("lrs_memory_budget","lmb",90);
+	    _lrsMemoryBudget.description=
+	    "Percentage of the memory limit that the LRS algorithm tries to stay within. The number of reachable clauses is also estimated from the memory growth per activated clause, and the limits are tightened so that passive clauses above them are discarded before the memory runs out. If 0, only the time limit is considered.";
+	    _lookup.insert(&_lrsMemoryBudget);
+	    _lrsMemoryBudget.tag(OptionTag::LRS);
+	    _lrsMemoryBudget.addConstraint(lessThanEq(100u));
+
 	    _lrsWeightLimitOnly = BoolOptionValue("lrs_weight_limit_only","lwlo",false);
 	    _lrsWeightLimitOnly.description=
 	    "If off, the lrs sets both age and weight limit according to clause reachability, otherwise it sets the age limit to 0 and only the weight limit reflects reachable clauses";
@@ -1340,6 +1439,16 @@ void Options::Options::init()
     _splittingCongruenceClosure.addHardConstraint(If(equal(SplittingCongruenceClosure::MODEL)).
                                                   then(_splittingMinimizeModel.is(notEqual(SplittingMinimizeModel::SCO))));
     
+    _avatarArithmetic = BoolOptionValue("avatar_arithmetic","aar",false);
+    _avatarArithmetic.description="Use a simplex-based decision procedure for ground linear arithmetic on top of the AVATAR SAT solver, so that"
+      " models of AVATAR in which the ground arithmetic components are inconsistent are refuted without Z3.";
+    _lookup.insert(&_avatarArithmetic);
+    _avatarArithmetic.tag(OptionTag::AVATAR);
+    _avatarArithmetic.reliesOn(_splitting.is(equal(true)));
+#if VZ3
+    _avatarArithmetic.reliesOn(_satSolver.is(notEqual(SatSolver::Z3)));
+#endif
+
     _ccUnsatCores = ChoiceOptionValue<CCUnsatCores>("cc_unsat_cores","ccuc",CCUnsatCores::ALL,
                                                      {"first", "small_ones", "all"});
     _ccUnsatCores.description="";
@@ -1349,6 +1458,13 @@ void Options::Options::init()
     _ccUnsatCores.setRandomChoices({"first", "small_ones", "all"});
     _ccUnsatCores.setExperimental();
 
+    _ccIncremental = BoolOptionValue("cc_incremental","cci",false);
+    _ccIncremental.description="Keep the equalities of the previous AVATAR model in the congruence closure and only retract and assert"
+      " those that changed, instead of rebuilding the closure for each model.";
+    _lookup.insert(&_ccIncremental);
+    _ccIncremental.tag(OptionTag::AVATAR);
+    _ccIncremental.reliesOn(_splittingCongruenceClosure.is(notEqual(SplittingCongruenceClosure::OFF)));
+
     _splittingLiteralPolarityAdvice = ChoiceOptionValue<SplittingLiteralPolarityAdvice>(
                                                 "avatar_literal_polarity_advice","alpa",
                                                 SplittingLiteralPolarityAdvice::NONE,
@@ -1398,6 +1514,22 @@ void Options::Options::init()
     _splittingBufferedSolver.reliesOn(_splitting.is(equal(true)));
     _splittingBufferedSolver.setRandomChoices({"on","off"});
 
+    _splittingAsyncModelBudget = UnsignedOptionValue("avatar_async_model_budget","aamb",0);
+    _splittingAsyncModelBudget.description=
+    "If non-zero, the SAT solver gets at most this many conflicts per saturation step to compute the next AVATAR model."
+    " When it does not finish, saturation continues with the previous model and the search is resumed at the next step."
+    " Zero means the model is always recomputed to completion before saturation continues.";
+    _lookup.insert(&_splittingAsyncModelBudget);
+    _splittingAsyncModelBudget.tag(OptionTag::AVATAR);
+    _splittingAsyncModelBudget.setExperimental();
+    _splittingAsyncModelBudget.reliesOn(_splitting.is(equal(true)));
+#if VZ3
+    _splittingAsyncModelBudget.reliesOn(_satSolver.is(notEqual(SatSolver::Z3)));
+#endif
+    // BufferedSolver does not support the UNKNOWN status of an interrupted search
+    _splittingAsyncModelBudget.addHardConstraint(If(notEqual(0u)).then(_splittingBufferedSolver.is(equal(false))));
+    _splittingAsyncModelBudget.setRandomChoices({"0","0","100","1000","10000"});
+
     _splittingDeleteDeactivated = ChoiceOptionValue<SplittingDeleteDeactivated>("avatar_delete_deactivated","add",
                                                                         SplittingDeleteDeactivated::ON,{"on","large","off"});
 
@@ -1408,6 +1540,24 @@ void Options::Options::init()
     _splittingDeleteDeactivated.reliesOn(_splitting.is(equal(true)));
     _splittingDeleteDeactivated.setRandomChoices({"on","large","off"});
 
+    _splittingLazyDeactivation = UnsignedOptionValue("avatar_lazy_deactivation","ald",0);
+    _splittingLazyDeactivation.description=
+    "If non-zero, active clauses depending on a deactivated component are not removed from the indices."
+    " They are only marked as dormant, skipped during retrieval, and become usable again as soon as the component is reactivated."
+    " A clause which stays dormant for more than the given number of model changes is removed for real.";
+    _lookup.insert(&_splittingLazyDeactivation);
+    _splittingLazyDeactivation.tag(OptionTag::AVATAR);
+    _splittingLazyDeactivation.setExperimental();
+    _splittingLazyDeactivation.reliesOn(_splitting.is(equal(true)));
+    // dormant clauses are tracked as the kept children of the deactivated components
+    _splittingLazyDeactivation.addHardConstraint(If(notEqual(0u)).then(_splittingDeleteDeactivated.is(notEqual(SplittingDeleteDeactivated::ON))));
+    // the acyclicity index does not know about dormant clauses
+    _splittingLazyDeactivation.addHardConstraint(If(notEqual(0u)).then(_termAlgebraCyclicityCheck.is(equal(TACyclicityCheck::OFF))));
+    // dormant clauses stay in the active container, so lazy_generation would
+    // build conclusions of their inferences while their components are false
+    _splittingLazyDeactivation.addHardConstraint(If(notEqual(0u)).then(_lazyGeneration.is(equal(false))));
+    _splittingLazyDeactivation.setRandomChoices({"0","0","10","100"});
+
 
     _splittingFlushPeriod = UnsignedOptionValue("avatar_flush_period","afp",0);
     _splittingFlushPeriod.description=
@@ -1705,6 +1855,16 @@ void Options::Options::init()
     _symbolPrecedenceBoost.tag(OptionTag::SATURATION);
     _lookup.insert(&_symbolPrecedenceBoost);
 
+    _kboCacheSize = UnsignedOptionValue("kbo_cache_size","kcs",0);
+    _kboCacheSize.description="Number of entries of a cache of KBO comparison results of pairs of shared terms."
+    " The number is rounded up to a power of two. Zero disables the cache.";
+    _kboCacheSize.tag(OptionTag::SATURATION);
+    _kboCacheSize.setExperimental();
+    _lookup.insert(&_kboCacheSize);
+    _kboCacheSize.reliesOn(_termOrdering.is(equal(TermOrdering::KBO)));
+    _kboCacheSize.addHardConstraint(lessThanEq(1u<<24));
+    _kboCacheSize.setRandomChoices({"0","0","4096","65536"});
+
     _weightIncrement = BoolOptionValue("weight_increment","",false);
     _weightIncrement.description="";
     //_lookup.insert(&_weightIncrement);
@@ -1820,6 +1820,9 @@ public:
   vstring testId() const { return _testId.actualValue; }
   vstring protectedPrefix() const { return _protectedPrefix.actualValue; }
   Statistics statistics() const { return _statistics.actualValue; }
+  vstring statsStream() const { return _statsStream.actualValue; }
+  unsigned statsStreamInterval() const { return _statsStreamInterval.actualValue; }
+  vstring indexTrace() const { return _indexTrace.actualValue; }
   void setStatistics(Statistics newVal) { _statistics.actualValue=newVal; }
   Proof proof() const { return _proof.actualValue; }
   ProofExtra proofExtra() const { return _proofExtra.actualValue; }
@@ -1940,6 +1943,7 @@ public:
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
+  unsigned lrsMemoryBudget() const { return _lrsMemoryBudget.actualValue; }
   int lookaheadDelay() const { return _lookaheadDelay.actualValue; }
   int simulatedTimeLimit() const { return _simulatedTimeLimit.actualValue; }
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
@@ -1947,6 +1951,7 @@ public:
   TermOrdering termOrdering() const { return _termOrdering.actualValue; }
   SymbolPrecedence symbolPrecedence() const { return _symbolPrecedence.actualValue; }
   SymbolPrecedenceBoost symbolPrecedenceBoost() const { return _symbolPrecedenceBoost.actualValue; }
+  unsigned kboCacheSize() const { return _kboCacheSize.actualValue; }
   const vstring& functionPrecedence() const { return _functionPrecedence.actualValue; }
   const vstring& predicatePrecedence() const { return _predicatePrecedence.actualValue; }
   // Return time limit in deciseconds, or 0 if there is no time limit
@@ -1959,6 +1964,12 @@ public:
   long maxPassive() const { return _maxPassive.actualValue; }
   int maxWeight() const { return _maxWeight.actualValue; }
   int ageRatio() const { return _ageWeightRatio.actualValue; }
+  bool compressPassive() const { return _compressPassive.actualValue; }
+  bool lazyGeneration() const { return _lazyGeneration.actualValue; }
+  vstring checkpointFile() const { return _checkpointFile.actualValue; }
+  vstring resumeFile() const { return _resumeFile.actualValue; }
+  unsigned termCollection() const { return _termCollection.actualValue; }
+  unsigned proofCompaction() const { return _proofCompaction.actualValue; }
   void setAgeRatio(int v){ _ageWeightRatio.actualValue = v; }
   int weightRatio() const { return _ageWeightRatio.otherValue; }
   void setWeightRatio(int v){ _ageWeightRatio.otherValue = v; }
@@ -2006,6 +2017,8 @@ public:
   RuleActivity generalSplitting() const { return _generalSplitting.actualValue; }
   vstring namePrefix() const { return _namePrefix.actualValue; }
   bool timeStatistics() const { return _timeStatistics.actualValue; }
+  vstring timeProfile() const { return _timeProfile.actualValue; }
+  bool hardwareCounters() const { return _hardwareCounters.actualValue; }
   bool splitting() const { return _splitting.actualValue; }
   void setSplitting(bool value){ _splitting.actualValue=value; }
   bool nonliteralsInClauseWeight() const { return _nonliteralsInClauseWeight.actualValue; }
@@ -2073,13 +2086,17 @@ public:
   SplittingMinimizeModel splittingMinimizeModel() const { return _splittingMinimizeModel.actualValue; }
   SplittingLiteralPolarityAdvice splittingLiteralPolarityAdvice() const { return _splittingLiteralPolarityAdvice.actualValue; }
   SplittingDeleteDeactivated splittingDeleteDeactivated() const { return _splittingDeleteDeactivated.actualValue;}
+  unsigned splittingLazyDeactivation() const { return _splittingLazyDeactivation.actualValue; }
   bool splittingFastRestart() const { return _splittingFastRestart.actualValue; }
   bool splittingBufferedSolver() const { return _splittingBufferedSolver.actualValue; }
+  unsigned splittingAsyncModelBudget() const { return _splittingAsyncModelBudget.actualValue; }
   int splittingFlushPeriod() const { return _splittingFlushPeriod.actualValue; }
   float splittingFlushQuotient() const { return _splittingFlushQuotient.actualValue; }
   bool splittingEagerRemoval() const { return _splittingEagerRemoval.actualValue; }
   SplittingCongruenceClosure splittingCongruenceClosure() const { return _splittingCongruenceClosure.actualValue; }
   CCUnsatCores ccUnsatCores() const { return _ccUnsatCores.actualValue; }
+  bool ccIncremental() const { return _ccIncremental.actualValue; }
+  bool avatarArithmetic() const { return _avatarArithmetic.actualValue; }
 
   void setProof(Proof p) { _proof.actualValue = p; }
   bool bpEquivalentVariableRemoval() const { return _equivalentVariableRemoval.actualValue; }
@@ -2210,6 +2227,12 @@ private:
   BoolOptionValue _encode;
 
   RatioOptionValue _ageWeightRatio;
+  BoolOptionValue _compressPassive;
+  BoolOptionValue _lazyGeneration;
+  StringOptionValue _checkpointFile;
+  StringOptionValue _resumeFile;
+  UnsignedOptionValue _termCollection;
+  UnsignedOptionValue _proofCompaction;
   BoolOptionValue _literalMaximalityAftercheck;
   BoolOptionValue _arityCheck;
   
@@ -2325,6 +2348,7 @@ private:
   IntOptionValue _lookaheadDelay;
   IntOptionValue _lrsFirstTimeCheck;
   BoolOptionValue _lrsWeightLimitOnly;
+  UnsignedOptionValue _lrsMemoryBudget;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
 
@@ -2422,7 +2446,9 @@ private:
   BoolOptionValue _splitAtActivation;
   ChoiceOptionValue<SplittingAddComplementary> _splittingAddComplementary;
   ChoiceOptionValue<SplittingCongruenceClosure> _splittingCongruenceClosure;
+  BoolOptionValue _avatarArithmetic;
   ChoiceOptionValue<CCUnsatCores> _ccUnsatCores;
+  BoolOptionValue _ccIncremental;
   BoolOptionValue _splittingEagerRemoval;
   UnsignedOptionValue _splittingFlushPeriod;
   FloatOptionValue _splittingFlushQuotient;
@@ -2430,14 +2456,20 @@ private:
   ChoiceOptionValue<SplittingMinimizeModel> _splittingMinimizeModel;
   ChoiceOptionValue<SplittingLiteralPolarityAdvice> _splittingLiteralPolarityAdvice;
   ChoiceOptionValue<SplittingDeleteDeactivated> _splittingDeleteDeactivated;
+  UnsignedOptionValue _splittingLazyDeactivation;
   BoolOptionValue _splittingFastRestart;
   BoolOptionValue _splittingBufferedSolver;
+  UnsignedOptionValue _splittingAsyncModelBudget;
 
   ChoiceOptionValue<Statistics> _statistics;
+  StringOptionValue _statsStream;
+  UnsignedOptionValue _statsStreamInterval;
+  StringOptionValue _indexTrace;
   BoolOptionValue _superpositionFromVariables;
   ChoiceOptionValue<TermOrdering> _termOrdering;
   ChoiceOptionValue<SymbolPrecedence> _symbolPrecedence;
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
+  UnsignedOptionValue _kboCacheSize;
   StringOptionValue _functionPrecedence;
   StringOptionValue _predicatePrecedence;
 
@@ -2450,6 +2482,8 @@ private:
   /** Time limit in deciseconds */
   TimeLimitOptionValue _timeLimitInDeciseconds;
   BoolOptionValue _timeStatistics;
+  StringOptionValue _timeProfile;
+  BoolOptionValue _hardwareCounters;
 
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
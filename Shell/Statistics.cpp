@@ -25,6 +25,8 @@
 
 #include <iostream>
 
+#include <unistd.h>
+
 #include "Debug/RuntimeStatistics.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -85,6 +87,7 @@ Statistics::Statistics()
     theoryInstSimpCandidates(0),
     theoryInstSimpTautologies(0),
     theoryInstSimpLostSolution(0),
+    theoryInstSimpCacheHits(0),
     induction(0),
     maxInductionDepth(0),
     inductionInProof(0),
@@ -113,10 +116,20 @@ Statistics::Statistics()
     taInjectivitySimplifications(0),
     taNegativeInjectivitySimplifications(0),
     taAcyclicityGeneratedDisequalities(0),
+    kboCacheHits(0),
+    kboCacheMisses(0),
     generatedClauses(0),
     passiveClauses(0),
     activeClauses(0),
     extensionalityClauses(0),
+    deferredInferences(0),
+    droppedDeferredInferences(0),
+    resumedClauses(0),
+    checkpointClauses(0),
+    termCollections(0),
+    collectedTerms(0),
+    proofCompactions(0),
+    proofLogRecords(0),
     discardedNonRedundantClauses(0),
     inferencesBlockedForOrderingAftercheck(0),
     smtReturnedUnknown(false),
@@ -166,11 +179,6 @@ void Statistics::print(ostream& out)
 
   SaturationAlgorithm::tryUpdateFinalClauseCount();
 
-  bool separable=false;
-#define HEADING(text,num) if (num) { addCommentSignForSZS(out); out << ">>> " << (text) << endl;}
-#define COND_OUT(text, num) if (num) { addCommentSignForSZS(out); out << (text) << ": " << (num) << endl; separable = true; }
-#define SEPARATOR if (separable) { addCommentSignForSZS(out); out << endl; separable = false; }
-
   addCommentSignForSZS(out);
   out << "------------------------------\n";
   addCommentSignForSZS(out);
@@ -231,6 +239,67 @@ void Statistics::print(ostream& out)
   out << endl;
 
   if (env.options->statistics()==Options::Statistics::FULL) {
+    printCounters(out, false);
+  }
+
+  addCommentSignForSZS(out);
+  out << "Memory used [KB]: " << Allocator::getUsedMemory()/1024 << endl;
+
+  addCommentSignForSZS(out);
+  out << "Time elapsed: ";
+  Timer::printMSString(out,env.timer->elapsedMilliseconds());
+  out << endl;
+  addCommentSignForSZS(out);
+  out << "------------------------------\n";
+
+  RSTAT_PRINT(out);
+  addCommentSignForSZS(out);
+  out << "------------------------------\n";
+
+  if (env.options && (env.options->timeStatistics() || env.options->hardwareCounters())) {
+    TimeCounter::printReport(out);
+  }
+  if (env.options && !env.options->timeProfile().empty()) {
+    TimeCounter::saveProfile(env.options->timeProfile());
+  }
+}
+
+/**
+ * Write a snapshot of the statistics into @b out as a single line
+ * holding a JSON object. Besides the counters that are not zero, it
+ * has the @b event that caused the snapshot, the process, the elapsed
+ * time, the phase, the memory used and the current numbers of active
+ * and passive clauses.
+ */
+void Statistics::printJson(ostream& out, const char* event)
+{
+  SaturationAlgorithm::tryUpdateFinalClauseCount();
+
+  out << "{\"event\":\"" << event << "\",\"pid\":" << getpid()
+      << ",\"time_ms\":" << env.timer->elapsedMilliseconds()
+      << ",\"phase\":\"" << phaseToString(phase) << "\""
+      << ",\"memory_kb\":" << Allocator::getUsedMemory()/1024
+      << ",\"active\":" << finalActiveClauses
+      << ",\"passive\":" << finalPassiveClauses
+      << ",\"counters\":{";
+  printCounters(out, true);
+  out << "}}" << endl;
+}
+
+/**
+ * Write the counters that are not zero into @b out, either as the
+ * sections of the full statistics, or if @b json is true, as
+ * comma-separated JSON members named by the descriptions of the counters.
+ */
+void Statistics::printCounters(ostream& out, bool json)
+{
+  bool separable=false;
+  bool first=true;
+#define HEADING(text,num) if (num && !json) { addCommentSignForSZS(out); out << ">>> " << (text) << endl;}
+#define COND_OUT(text, num) if (num) { \
+    if (json) { out << (first ? "" : ",") << "\"" << (text) << "\":" << (num); first = false; } \
+    else { addCommentSignForSZS(out); out << (text) << ": " << (num) << endl; separable = true; } }
+#define SEPARATOR if (separable) { addCommentSignForSZS(out); out << endl; separable = false; }
 
   HEADING("Input",inputClauses+inputFormulas);
   COND_OUT("Input clauses", inputClauses);
@@ -251,10 +320,18 @@ void Statistics::print(ostream& out)
   SEPARATOR;
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
-      generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
+      generatedClauses+deferredInferences+resumedClauses+checkpointClauses+termCollections+proofCompactions+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
       discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
+  COND_OUT("Deferred inferences", deferredInferences);
+  COND_OUT("Dropped deferred inferences", droppedDeferredInferences);
+  COND_OUT("Resumed clauses", resumedClauses);
+  COND_OUT("Checkpoint clauses", checkpointClauses);
+  COND_OUT("Term collections", termCollections);
+  COND_OUT("Collected terms", collectedTerms);
+  COND_OUT("Proof log compactions", proofCompactions);
+  COND_OUT("Proof log records", proofLogRecords);
   COND_OUT("Active clauses", activeClauses);
   COND_OUT("Passive clauses", passiveClauses);
   COND_OUT("Extensionality clauses", extensionalityClauses);
@@ -304,7 +381,7 @@ void Statistics::print(ostream& out)
       cForwardSuperposition+cBackwardSuperposition+cSelfSuperposition+
       equalityFactoring+equalityResolution+forwardExtensionalityResolution+
       backwardExtensionalityResolution+
-      theoryInstSimp+theoryInstSimpCandidates+theoryInstSimpTautologies+theoryInstSimpLostSolution+induction);
+      theoryInstSimp+theoryInstSimpCandidates+theoryInstSimpTautologies+theoryInstSimpLostSolution+theoryInstSimpCacheHits+induction);
   COND_OUT("Binary resolution", resolution);
   COND_OUT("Unit resulting resolution", urResolution);
   COND_OUT("Binary resolution with abstraction",cResolution);
@@ -323,6 +400,7 @@ void Statistics::print(ostream& out)
   COND_OUT("TheoryInstSimpCandidates",theoryInstSimpCandidates);
   COND_OUT("TheoryInstSimpTautologies",theoryInstSimpTautologies);
   COND_OUT("TheoryInstSimpLostSolution",theoryInstSimpLostSolution);
+  COND_OUT("TheoryInstSimpCacheHits",theoryInstSimpCacheHits);
   COND_OUT("Induction",induction);
   COND_OUT("MaxInductionDepth",maxInductionDepth);
   COND_OUT("InductionStepsInProof",inductionInProof);
@@ -337,6 +415,14 @@ void Statistics::print(ostream& out)
   COND_OUT("Negative injectivity simplifications",taNegativeInjectivitySimplifications);
   COND_OUT("Disequalities generated from acyclicity",taAcyclicityGeneratedDisequalities);
 
+  HEADING("Term ordering",kboCacheHits+kboCacheMisses);
+  COND_OUT("KBO cache hits",kboCacheHits);
+  COND_OUT("KBO cache misses",kboCacheMisses);
+  if(kboCacheHits+kboCacheMisses) {
+    COND_OUT("KBO cache hit rate [%]",(kboCacheHits*100)/(kboCacheHits+kboCacheMisses));
+  }
+  SEPARATOR;
+
   HEADING("AVATAR",splitClauses+splitComponents+uniqueComponents+satSplits+
         satSplitRefutations);
   COND_OUT("Split clauses", splitClauses);
@@ -376,27 +462,9 @@ void Statistics::print(ostream& out)
   COND_OUT("Pure propositional variables eliminated by SAT solver", satPureVarsEliminated);
   SEPARATOR;
 
-  }
-
-  COND_OUT("Memory used [KB]", Allocator::getUsedMemory()/1024);
-
-  addCommentSignForSZS(out);
-  out << "Time elapsed: ";
-  Timer::printMSString(out,env.timer->elapsedMilliseconds());
-  out << endl;
-  addCommentSignForSZS(out);
-  out << "------------------------------\n";
-
-  RSTAT_PRINT(out);
-  addCommentSignForSZS(out);
-  out << "------------------------------\n";
-
 #undef SEPARATOR
 #undef COND_OUT
-
-  if (env.options && env.options->timeStatistics()) {
-    TimeCounter::printReport(out);
-  }
+#undef HEADING
 }
 
 const char* Statistics::phaseToString(ExecutionPhase p)
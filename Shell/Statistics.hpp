@@ -63,6 +63,7 @@ public:
   Statistics();
 
   void print(ostream& out);
+  void printJson(ostream& out, const char* event);
 
   // Input
   /** number of input clauses */
@@ -133,6 +134,8 @@ public:
   unsigned theoryInstSimpTautologies;
   /** number of theoryInstSimp solutions lost as we could not represent them **/
   unsigned theoryInstSimpLostSolution;
+  /** number of theoryInstSimp solutions taken from the cache instead of calling the SMT solver **/
+  unsigned theoryInstSimpCacheHits;
   /** number of induction applications **/
   unsigned induction;
   unsigned maxInductionDepth;
@@ -189,6 +192,10 @@ public:
   unsigned taNegativeInjectivitySimplifications;
   unsigned taAcyclicityGeneratedDisequalities;
 
+  /** statistics of the KBO comparison cache */
+  unsigned long kboCacheHits;
+  unsigned long kboCacheMisses;
+
   // Saturation
   /** all clauses ever occurring in the unprocessed queue */
   unsigned generatedClauses;
@@ -198,6 +205,22 @@ public:
   unsigned activeClauses;
   /** all extensionality clauses */
   unsigned extensionalityClauses;
+  /** generating inferences stored as recipes in passive */
+  unsigned deferredInferences;
+  /** recipes dropped because a premise was no longer active */
+  unsigned droppedDeferredInferences;
+  /** clauses loaded from a checkpoint (the resume_file option) */
+  unsigned resumedClauses;
+  /** clauses saved to a checkpoint (the checkpoint_file option) */
+  unsigned checkpointClauses;
+  /** runs of the collection of unused shared terms (the term_collection option) */
+  unsigned termCollections;
+  /** shared terms and literals destroyed by the collections */
+  unsigned long collectedTerms;
+  /** runs of the compaction of the proof log (the proof_compaction option) */
+  unsigned proofCompactions;
+  /** records in the proof log after the last compaction */
+  unsigned proofLogRecords;
 
   unsigned discardedNonRedundantClauses;
 
@@ -412,6 +435,7 @@ public:
   ExecutionPhase phase;
 
 private:
+  void printCounters(ostream& out, bool json);
   static const char* phaseToString(ExecutionPhase p);
 }; // class Statistics
 
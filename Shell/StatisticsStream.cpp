@@ -0,0 +1,167 @@
+
+/*
+ * File StatisticsStream.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file StatisticsStream.cpp
+ * Implements class StatisticsStream.
+ */
+
+#include <climits>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Options.hpp"
+#include "Statistics.hpp"
+
+#include "StatisticsStream.hpp"
+
+namespace Shell
+{
+
+int StatisticsStream::s_fd = -1;
+int StatisticsStream::s_nextSnapshot = 0;
+
+/**
+ * Take a snapshot if the interval given by the stats_stream_interval
+ * option has passed since the previous one. Meant to be called often,
+ * e.g. after each step of the saturation loop.
+ */
+void StatisticsStream::tick()
+{
+  int now=env.timer->elapsedMilliseconds();
+  if(now<s_nextSnapshot) {
+    return;
+  }
+  unsigned interval=env.options->statsStreamInterval();
+  if(!interval || !ensureOpen()) {
+    s_nextSnapshot=INT_MAX;
+    return;
+  }
+  snapshot("progress");
+  s_nextSnapshot=now+interval;
+}
+
+/**
+ * Write a snapshot of the statistics with the name of the @b event
+ * that caused it, if the stream is used
+ */
+void StatisticsStream::snapshot(const char* event)
+{
+  CALL("StatisticsStream::snapshot");
+
+  if(!ensureOpen()) {
+    return;
+  }
+  vostringstream out;
+  env.statistics->printJson(out, event);
+  write(out.str());
+}
+
+void StatisticsStream::sliceStarted(pid_t pid, vstring sliceCode)
+{
+  CALL("StatisticsStream::sliceStarted");
+
+  if(!ensureOpen()) {
+    return;
+  }
+  vostringstream out;
+  out << "{\"event\":\"slice_start\",\"pid\":" << pid << ",\"time_ms\":" << env.timer->elapsedMilliseconds()
+      << ",\"slice\":\"" << sliceCode << "\"}" << endl;
+  write(out.str());
+}
+
+/**
+ * Record the end of the slice running in the process @b pid with the
+ * exit status @b exitStatus, which is zero when the slice found a
+ * proof and negative when the slice was killed by the portfolio
+ */
+void StatisticsStream::sliceFinished(pid_t pid, int exitStatus)
+{
+  CALL("StatisticsStream::sliceFinished");
+
+  if(!ensureOpen()) {
+    return;
+  }
+  vostringstream out;
+  out << "{\"event\":\"slice_end\",\"pid\":" << pid << ",\"time_ms\":" << env.timer->elapsedMilliseconds()
+      << ",\"status\":" << exitStatus << "}" << endl;
+  write(out.str());
+}
+
+void StatisticsStream::scheduleFinished(bool success)
+{
+  CALL("StatisticsStream::scheduleFinished");
+
+  if(!ensureOpen()) {
+    return;
+  }
+  vostringstream out;
+  out << "{\"event\":\"schedule_end\",\"pid\":" << getpid() << ",\"time_ms\":" << env.timer->elapsedMilliseconds()
+      << ",\"success\":" << (success ? "true" : "false") << "}" << endl;
+  write(out.str());
+}
+
+/**
+ * Open the stream if the stats_stream option is set and it was not
+ * opened before, and return true if the stream is open
+ */
+bool StatisticsStream::ensureOpen()
+{
+  CALL("StatisticsStream::ensureOpen");
+
+  static bool initialized=false;
+  if(initialized) {
+    return s_fd!=-1;
+  }
+  initialized=true;
+
+  if(!env.options || env.options->statsStream().empty()) {
+    return false;
+  }
+  vstring fileName=env.options->statsStream();
+  s_fd=open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0666);
+  if(s_fd==-1) {
+    USER_ERROR("Cannot open statistics stream: "+fileName);
+  }
+  System::addTerminationHandler(onTermination);
+  return true;
+}
+
+/**
+ * Write @b line at once, so that it is not interleaved with the lines
+ * of other processes. Errors are ignored, as the proof search should
+ * not depend on whoever reads the stream.
+ */
+void StatisticsStream::write(const vstring& line)
+{
+  ssize_t res=::write(s_fd, line.data(), line.size());
+  (void)res;
+}
+
+void StatisticsStream::onTermination()
+{
+  snapshot("end");
+}
+
+}
@@ -0,0 +1,67 @@
+
+/*
+ * File StatisticsStream.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file StatisticsStream.hpp
+ * Defines class StatisticsStream.
+ */
+
+#ifndef __StatisticsStream__
+#define __StatisticsStream__
+
+#include <sys/types.h>
+
+#include "Lib/VString.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+
+/**
+ * Periodic snapshots of the statistics appended as JSON lines to the
+ * file given by the stats_stream option (see Statistics::printJson).
+ *
+ * Each line is written by a single system call, so that the processes
+ * of a portfolio can share the file. The portfolio parent adds lines
+ * for the slices it starts and that finish, which carry the pid of the
+ * slice as the snapshots written by the slice itself.
+ */
+class StatisticsStream
+{
+public:
+  static void tick();
+  static void snapshot(const char* event);
+
+  static void sliceStarted(pid_t pid, vstring sliceCode);
+  static void sliceFinished(pid_t pid, int exitStatus);
+  static void scheduleFinished(bool success);
+
+private:
+  static bool ensureOpen();
+  static void write(const vstring& line);
+  static void onTermination();
+
+  /** descriptor of the stream, or -1 */
+  static int s_fd;
+  /** elapsed milliseconds when tick() takes the next snapshot */
+  static int s_nextSnapshot;
+};
+
+}
+
+#endif // __StatisticsStream__
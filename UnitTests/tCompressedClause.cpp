@@ -0,0 +1,75 @@
+
+/*
+ * File tCompressedClause.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/CompressedClause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID compressedClause
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+TEST_FUN(compressedClauseRoundTrip)
+{
+  //clauses created before the end of preprocessing are never compressed
+  Unit::onPreprocessingEnd();
+
+  unsigned f = env.signature->addFunction("cc_f",2);
+  unsigned p = env.signature->addPredicate("cc_p",1);
+  unsigned q = env.signature->addPredicate("cc_q",2);
+  TermList a(Term::createConstant(env.signature->addFunction("cc_a",0)));
+  TermList x(0,false);
+  TermList y(3,false);
+  TermList fxa(Term::create2(f,x,a));
+  TermList ffxaa(Term::create2(f,fxa,a));
+
+  Stack<Literal*> lits;
+  lits.push(Literal::create1(p,true,ffxaa));
+  lits.push(Literal::create2(q,false,y,fxa));
+  lits.push(Literal::createEquality(false,x,y,Sorts::SRT_DEFAULT));
+  lits.push(Literal::createEquality(true,fxa,a,Sorts::SRT_DEFAULT));
+
+  Clause* cl = Clause::fromStack(lits, Unit::AXIOM, new Inference(Inference::INPUT));
+  cl->setAge(7);
+  unsigned number = cl->number();
+
+  ASS(CompressedClause::canCompress(cl));
+  CompressedClause* ccl = CompressedClause::compress(cl);
+  ASS(ccl);
+  ASS_EQ(ccl->length(), 4);
+  ASS_EQ(ccl->number(), number);
+
+  Clause* res = ccl->decompress();
+  ASS_EQ(res->number(), number);
+  ASS_EQ(res->age(), 7);
+  ASS_EQ(res->length(), lits.size());
+  for (unsigned i = 0; i < lits.size(); i++) {
+    ASS_EQ((*res)[i], lits[i]);
+  }
+}
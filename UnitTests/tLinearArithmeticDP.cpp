@@ -0,0 +1,148 @@
+
+/*
+ * File tLinearArithmeticDP.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/Theory.hpp"
+
+#include "DP/LinearArithmeticDP.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID linearArithmeticDP
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace DP;
+
+static TermList constant(const char* name, unsigned sort)
+{
+  unsigned f = env.signature->addFunction(name,0);
+  env.signature->getFunction(f)->setType(OperatorType::getConstantsType(sort));
+  return TermList(Term::createConstant(f));
+}
+
+static TermList number(int num)
+{
+  return TermList(theory->representConstant(IntegerConstantType(num)));
+}
+
+static TermList binary(Theory::Interpretation itp, TermList t1, TermList t2)
+{
+  return TermList(Term::create2(env.signature->getInterpretingSymbol(itp),t1,t2));
+}
+
+static Literal* compare(Theory::Interpretation itp, bool polarity, TermList t1, TermList t2)
+{
+  return Literal::create2(env.signature->getInterpretingSymbol(itp),polarity,t1,t2);
+}
+
+static DecisionProcedure::Status check(DecisionProcedure& dp, LiteralStack& lits)
+{
+  dp.reset();
+  dp.addLiterals(pvi( LiteralStack::ConstIterator(lits) ));
+  return dp.getStatus(true);
+}
+
+TEST_FUN(linearArithmeticRationals)
+{
+  TermList a = constant("lad_a",Sorts::SRT_RATIONAL);
+  TermList b = constant("lad_b",Sorts::SRT_RATIONAL);
+  TermList c = constant("lad_c",Sorts::SRT_RATIONAL);
+  TermList zero(theory->representConstant(RationalConstantType(0)));
+  TermList two(theory->representConstant(RationalConstantType(2)));
+
+  LinearArithmeticDP dp;
+  LiteralStack lits;
+
+  // a<b, a=2b, b>0
+  Literal* aLessB = compare(Theory::RAT_LESS,true,a,b);
+  lits.push(aLessB);
+  lits.push(Literal::createEquality(true,a,binary(Theory::RAT_MULTIPLY,two,b),Sorts::SRT_RATIONAL));
+  lits.push(compare(Theory::RAT_GREATER,true,b,zero));
+  ASS(check(dp,lits)==DecisionProcedure::UNSATISFIABLE);
+  ASS_EQ(dp.getUnsatCoreCount(),1);
+  LiteralStack core;
+  dp.getUnsatCore(core,0);
+  ASS_EQ(core.size(),3);
+
+  // a<b, b<c, ~(a<c) is a conflict, without the last literal there is none
+  lits.reset();
+  lits.push(aLessB);
+  lits.push(compare(Theory::RAT_LESS,true,b,c));
+  ASS(check(dp,lits)==DecisionProcedure::SATISFIABLE);
+  lits.push(compare(Theory::RAT_LESS,false,a,c));
+  ASS(check(dp,lits)==DecisionProcedure::UNSATISFIABLE);
+  lits.pop();
+  ASS(check(dp,lits)==DecisionProcedure::SATISFIABLE);
+
+  // a=b and a!=b are only detected as inconsistent by the model
+  lits.reset();
+  lits.push(Literal::createEquality(true,a,b,Sorts::SRT_RATIONAL));
+  lits.push(Literal::createEquality(false,b,a,Sorts::SRT_RATIONAL));
+  ASS(check(dp,lits)==DecisionProcedure::UNKNOWN);
+}
+
+TEST_FUN(linearArithmeticIntegers)
+{
+  TermList x = constant("lad_x",Sorts::SRT_INTEGER);
+  TermList y = constant("lad_y",Sorts::SRT_INTEGER);
+
+  LinearArithmeticDP dp;
+  LiteralStack lits;
+
+  // 0<x, x<1 has no integer solution
+  lits.push(compare(Theory::INT_LESS,true,number(0),x));
+  lits.push(compare(Theory::INT_LESS,true,x,number(1)));
+  ASS(check(dp,lits)==DecisionProcedure::UNSATISFIABLE);
+
+  // 2x=1
+  lits.reset();
+  lits.push(Literal::createEquality(true,binary(Theory::INT_MULTIPLY,number(2),x),number(1),Sorts::SRT_INTEGER));
+  ASS(check(dp,lits)==DecisionProcedure::UNSATISFIABLE);
+
+  // 2x+2y=1 becomes x+y=1/2
+  lits.reset();
+  TermList sum = binary(Theory::INT_PLUS,binary(Theory::INT_MULTIPLY,number(2),x),
+      binary(Theory::INT_MULTIPLY,number(2),y));
+  lits.push(Literal::createEquality(true,sum,number(1),Sorts::SRT_INTEGER));
+  ASS(check(dp,lits)==DecisionProcedure::UNSATISFIABLE);
+
+  // 2x+3y=1 with 0<=y<=0 has only rational solutions, which are not recognized
+  sum = binary(Theory::INT_PLUS,binary(Theory::INT_MULTIPLY,number(2),x),
+      binary(Theory::INT_MULTIPLY,number(3),y));
+  lits.reset();
+  lits.push(Literal::createEquality(true,sum,number(1),Sorts::SRT_INTEGER));
+  lits.push(compare(Theory::INT_LESS_EQUAL,true,y,number(0)));
+  lits.push(compare(Theory::INT_GREATER_EQUAL,true,y,number(0)));
+  ASS(check(dp,lits)==DecisionProcedure::UNKNOWN);
+
+  // x-y>=3, y>=x
+  lits.reset();
+  lits.push(compare(Theory::INT_GREATER_EQUAL,true,binary(Theory::INT_MINUS,x,y),number(3)));
+  lits.push(compare(Theory::INT_LESS,false,y,x));
+  ASS(check(dp,lits)==DecisionProcedure::UNSATISFIABLE);
+  lits.pop();
+  ASS(check(dp,lits)==DecisionProcedure::SATISFIABLE);
+}
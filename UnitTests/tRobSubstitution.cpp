@@ -0,0 +1,99 @@
+
+/*
+ * File tRobSubstitution.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+
+#include "Lib/Backtrackable.hpp"
+#include "Lib/Environment.hpp"
+
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID robSubstitution
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+TEST_FUN(robUnifyAndBacktrack)
+{
+  unsigned f = env.signature->addFunction("rs_f",2);
+  unsigned g = env.signature->addFunction("rs_g",1);
+  TermList a(Term::createConstant(env.signature->addFunction("rs_a",0)));
+  TermList b(Term::createConstant(env.signature->addFunction("rs_b",0)));
+  TermList x(0,false);
+  TermList y(1,false);
+
+  TermList fxgy(Term::create2(f,x,TermList(Term::create1(g,y))));
+  TermList fagb(Term::create2(f,a,TermList(Term::create1(g,b))));
+
+  RobSubstitution subst;
+  BacktrackData bd;
+  subst.bdRecord(bd);
+  ASS(subst.unify(fxgy,0,fagb,1));
+  subst.bdDone();
+
+  ASS(!subst.isUnbound(0,0));
+  ASS(!subst.isUnbound(1,0));
+  ASS_EQ(subst.apply(fxgy,0),fagb);
+
+  bd.backtrack();
+  ASS(subst.isUnbound(0,0));
+  ASS(subst.isUnbound(1,0));
+}
+
+TEST_FUN(robFailedUnificationLeavesNoBindings)
+{
+  unsigned f = env.signature->addFunction("rs_f",2);
+  TermList a(Term::createConstant(env.signature->addFunction("rs_a",0)));
+  TermList b(Term::createConstant(env.signature->addFunction("rs_b",0)));
+  TermList x(0,false);
+
+  //x is bound to a before the second argument clashes
+  TermList fxa(Term::create2(f,x,a));
+  TermList fab(Term::create2(f,a,b));
+
+  RobSubstitution subst;
+  ASS(!subst.unify(fxa,0,fab,1));
+  ASS(subst.isUnbound(0,0));
+}
+
+TEST_FUN(robLargeVariables)
+{
+  //variables with large numbers and banks are not kept in the flat array
+  unsigned f = env.signature->addFunction("rs_f",2);
+  TermList a(Term::createConstant(env.signature->addFunction("rs_a",0)));
+  TermList x(1000,false);
+  TermList y(3,false);
+
+  TermList fxx(Term::create2(f,x,x));
+  TermList fya(Term::create2(f,y,a));
+
+  RobSubstitution subst;
+  ASS(subst.unify(fxx,0,fya,17));
+  ASS(!subst.isUnbound(3,17));
+  ASS_EQ(subst.apply(x,0),a);
+  ASS_EQ(subst.apply(y,17),a);
+
+  subst.reset();
+  ASS(subst.isUnbound(1000,0));
+  ASS(subst.isUnbound(3,17));
+}
@@ -0,0 +1,67 @@
+
+/*
+ * File tSharedSet.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+
+#include "Lib/SharedSet.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID sharedSet
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+
+typedef const SharedSet<unsigned> USet;
+
+TEST_FUN(sharedSetUnion)
+{
+  unsigned a1[] = {1,3,5,7};
+  unsigned a2[] = {2,3,6};
+  unsigned a3[] = {1,2,3,5,6,7};
+
+  USet* s1 = USet::getFromArray(a1, 4);
+  USet* s2 = USet::getFromArray(a2, 3);
+  USet* s3 = USet::getFromArray(a3, 6);
+
+  ASS_EQ(s1->getUnion(s2), s3);
+  ASS_EQ(s2->getUnion(s1), s3);
+  // the second time around the result comes from the union cache
+  ASS_EQ(s1->getUnion(s2), s3);
+  ASS_EQ(s2->getUnion(s1), s3);
+
+  ASS_EQ(s1->getUnion(s3), s3);
+  ASS_EQ(s3->getUnion(s1), s3);
+  ASS_EQ(s1->getUnion(USet::getEmpty()), s1);
+  ASS_EQ(USet::getEmpty()->getUnion(s2), s2);
+}
+
+TEST_FUN(sharedSetManyUnions)
+{
+  // enough pairs to make the cache entries collide and get overwritten
+  for(unsigned round=0; round<2; round++) {
+    for(unsigned i=0; i<200; i++) {
+      for(unsigned j=0; j<50; j++) {
+        USet* u = USet::getSingleton(i)->getUnion(USet::getSingleton(1000+j));
+        ASS_EQ(u->size(), 2u);
+        ASS(u->member(i));
+        ASS(u->member(1000+j));
+      }
+    }
+  }
+}
@@ -0,0 +1,80 @@
+
+/*
+ * File tTermSharing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID termSharing
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+TEST_FUN(termCollection)
+{
+  unsigned f = env.signature->addFunction("ts_f",1);
+  unsigned g = env.signature->addFunction("ts_g",1);
+  unsigned h = env.signature->addFunction("ts_h",1);
+  unsigned p = env.signature->addPredicate("ts_p",1);
+  TermList x(0,false);
+
+  // terms created before are never collected
+  Term* old = Term::create1(h,x);
+
+  env.sharing->enableCollection();
+  Term* fx = Term::create1(f,x);
+  Term* gfx = Term::create1(g,TermList(fx));
+  Term* ffx = Term::create1(f,TermList(fx));
+  Term* gx = Term::create1(g,x);
+  ASS(gx->shared());
+
+  Stack<Literal*> lits;
+  lits.push(Literal::create1(p,true,TermList(gfx)));
+  Clause* cl = Clause::fromStack(lits, Unit::AXIOM, new Inference(Inference::INPUT));
+  env.sharing->pin(ffx);
+  env.sharing->pin(ffx);
+
+  // only g(X0) is neither in the clause nor pinned
+  ASS_EQ(env.sharing->collect(), 1);
+  ASS_EQ(env.sharing->collections(), 1);
+  ASS_EQ(Term::create1(f,x), fx);
+  ASS_EQ(Term::create1(g,TermList(fx)), gfx);
+  ASS_EQ(Term::create1(h,x), old);
+
+  // the literal and g(f(X0)) go with the clause
+  cl->destroy();
+  ASS_EQ(env.sharing->collect(), 2);
+
+  // f(f(X0)) is pinned twice
+  env.sharing->unpin(ffx);
+  ASS_EQ(env.sharing->collect(), 0);
+  env.sharing->unpin(ffx);
+  ASS_EQ(env.sharing->collect(), 2);
+  ASS_EQ(env.sharing->collections(), 4);
+}
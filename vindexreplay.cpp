@@ -0,0 +1,294 @@
+/*
+ * File vindexreplay.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file vindexreplay.cpp
+ * Replays the operations recorded with the index_trace option on
+ * freshly built indexing structures and reports their throughput.
+ *
+ * Usage: vindexreplay <trace file> [-t subst|code]
+ *
+ * With -t, the term indices are built as substitution trees or code
+ * trees instead of the structures used in the recorded run. Code trees
+ * are used only for indices that were not asked queries other than
+ * generalizations. All results
+ * of each query are retrieved, and their numbers are compared with
+ * those of the recorded run.
+ */
+#include <ctime>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+
+#include "Forwards.hpp"
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/IndexTrace.hpp"
+#include "Indexing/LiteralSubstitutionTree.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Shell/Options.hpp"
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+using namespace Indexing;
+
+/** An indexing structure of the replayed run */
+struct ReplayIndex
+{
+  bool literalIndex;
+  IndexTrace::Structure structure;
+  TermIndexingStructure* tis;
+  LiteralIndexingStructure* lis;
+};
+
+/** Totals of one kind of operations */
+struct OperationTotal
+{
+  unsigned count;
+  long long nanoseconds;
+  unsigned long long results;
+  unsigned mismatches;
+};
+
+static long long now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1000000000LL+ts.tv_nsec;
+}
+
+static Clause* dummyClause(unsigned number)
+{
+  static DHMap<unsigned,Clause*> clauses;
+  Clause** pcl;
+  if(clauses.getValuePtr(number, pcl)) {
+    *pcl=new(0) Clause(0, Unit::AXIOM, new Inference(Inference::INPUT));
+  }
+  return *pcl;
+}
+
+static unsigned termQuery(TermIndexingStructure* tis, const IndexTrace::Entry& e)
+{
+  switch(e.op) {
+  case IndexTrace::UNIFICATIONS:
+    return countIteratorElements(tis->getUnifications(e.term, e.retrieveSubstitutions));
+  case IndexTrace::UNIFICATIONS_WITH_CONSTRAINTS:
+    return countIteratorElements(tis->getUnificationsWithConstraints(e.term, e.retrieveSubstitutions));
+  case IndexTrace::GENERALIZATIONS:
+    return countIteratorElements(tis->getGeneralizations(e.term, e.retrieveSubstitutions));
+  case IndexTrace::INSTANCES:
+    return countIteratorElements(tis->getInstances(e.term, e.retrieveSubstitutions));
+  case IndexTrace::GENERALIZATION_EXISTS:
+    return tis->generalizationExists(e.term);
+  default:
+    ASSERTION_VIOLATION;
+  }
+  return 0;
+}
+
+static unsigned literalQuery(LiteralIndexingStructure* lis, const IndexTrace::Entry& e)
+{
+  switch(e.op) {
+  case IndexTrace::UNIFICATIONS:
+    return countIteratorElements(lis->getUnifications(e.lit, e.complementary, e.retrieveSubstitutions));
+  case IndexTrace::UNIFICATIONS_WITH_CONSTRAINTS:
+    return countIteratorElements(lis->getUnificationsWithConstraints(e.lit, e.complementary,
+        e.retrieveSubstitutions));
+  case IndexTrace::GENERALIZATIONS:
+    return countIteratorElements(lis->getGeneralizations(e.lit, e.complementary, e.retrieveSubstitutions));
+  case IndexTrace::INSTANCES:
+    return countIteratorElements(lis->getInstances(e.lit, e.complementary, e.retrieveSubstitutions));
+  case IndexTrace::VARIANTS:
+    return countIteratorElements(lis->getVariants(e.lit, e.complementary, e.retrieveSubstitutions));
+  default:
+    ASSERTION_VIOLATION;
+  }
+  return 0;
+}
+
+/**
+ * Code trees answer only generalization queries
+ */
+static bool supportedByCodeTree(IndexTrace::Operation op)
+{
+  return op==IndexTrace::INSERT || op==IndexTrace::REMOVE || op==IndexTrace::GENERALIZATIONS ||
+      op==IndexTrace::GENERALIZATION_EXISTS;
+}
+
+static void replay(vstring fileName, bool overrideTerm, IndexTrace::Structure termStructure)
+{
+  CALL("replay");
+
+  Stack<IndexTrace::Entry> entries;
+  IndexTrace::load(fileName, entries);
+
+  //the clauses are created before the memory baseline is taken
+  Stack<bool> codeTreeUsable;
+  for(size_t i=0; i<entries.size(); i++) {
+    const IndexTrace::Entry& e=entries[i];
+    if(e.op==IndexTrace::NEW_TERM_INDEX || e.op==IndexTrace::NEW_LITERAL_INDEX) {
+      codeTreeUsable.push(e.op==IndexTrace::NEW_TERM_INDEX);
+    }
+    else if(!supportedByCodeTree(e.op)) {
+      codeTreeUsable[e.index]=false;
+    }
+    if(e.op==IndexTrace::INSERT || e.op==IndexTrace::REMOVE) {
+      dummyClause(e.clause);
+    }
+  }
+
+  OperationTotal totals[IndexTrace::OPERATION_COUNT];
+  memset(totals, 0, sizeof(totals));
+  Stack<ReplayIndex> indices;
+  size_t baseMemory=Allocator::getUsedMemory();
+  size_t peakMemory=baseMemory;
+
+  for(size_t i=0; i<entries.size(); i++) {
+    const IndexTrace::Entry& e=entries[i];
+    OperationTotal& total=totals[e.op];
+    if(e.op==IndexTrace::NEW_TERM_INDEX || e.op==IndexTrace::NEW_LITERAL_INDEX) {
+      ReplayIndex idx;
+      idx.literalIndex=e.op==IndexTrace::NEW_LITERAL_INDEX;
+      idx.structure=(overrideTerm && !idx.literalIndex) ? termStructure : e.structure;
+      if(idx.structure==IndexTrace::CODE_TREE && !codeTreeUsable[e.index]) {
+        cout<<"Index "<<e.index<<" is a substitution tree, as code trees do not support its queries"<<endl;
+        idx.structure=IndexTrace::SUBSTITUTION_TREE;
+      }
+      idx.tis=0;
+      idx.lis=0;
+      if(idx.literalIndex) {
+        idx.lis=new LiteralSubstitutionTree(e.useConstraints);
+      }
+      else if(idx.structure==IndexTrace::CODE_TREE) {
+        idx.tis=new CodeTreeTIS();
+      }
+      else {
+        idx.tis=new TermSubstitutionTree(e.useConstraints);
+      }
+      indices.push(idx);
+      total.count++;
+      continue;
+    }
+
+    ReplayIndex& idx=indices[e.index];
+    long long start=now();
+    unsigned results=0;
+    switch(e.op) {
+    case IndexTrace::INSERT:
+      if(idx.literalIndex) {
+        idx.lis->insert(e.lit, dummyClause(e.clause));
+      }
+      else {
+        idx.tis->insert(e.term, e.lit, dummyClause(e.clause));
+      }
+      break;
+    case IndexTrace::REMOVE:
+      if(idx.literalIndex) {
+        idx.lis->remove(e.lit, dummyClause(e.clause));
+      }
+      else {
+        idx.tis->remove(e.term, e.lit, dummyClause(e.clause));
+      }
+      break;
+    default:
+      results=idx.literalIndex ? literalQuery(idx.lis, e) : termQuery(idx.tis, e);
+      total.results+=results;
+      if(results!=e.results) {
+        total.mismatches++;
+      }
+    }
+    total.nanoseconds+=now()-start;
+    total.count++;
+    if(e.op==IndexTrace::INSERT) {
+      size_t mem=Allocator::getUsedMemory();
+      if(mem>peakMemory) {
+        peakMemory=mem;
+      }
+    }
+  }
+
+  long long allNanoseconds=0;
+  cout<<"Replayed "<<entries.size()<<" operations on "<<indices.size()<<" indices"<<endl;
+  cout<<setw(32)<<left<<"operation"<<setw(12)<<right<<"count"<<setw(12)<<"time [ms]"
+      <<setw(14)<<"ops/s"<<setw(14)<<"results"<<setw(12)<<"mismatches"<<endl;
+  for(unsigned i=IndexTrace::INSERT; i<IndexTrace::OPERATION_COUNT; i++) {
+    OperationTotal& total=totals[i];
+    if(!total.count) {
+      continue;
+    }
+    allNanoseconds+=total.nanoseconds;
+    cout<<setw(32)<<left<<IndexTrace::operationName(static_cast<IndexTrace::Operation>(i))
+        <<setw(12)<<right<<total.count<<setw(12)<<fixed<<setprecision(1)<<total.nanoseconds/1000000.0
+        <<setw(14)<<setprecision(0)<<(total.nanoseconds ? total.count*1e9/total.nanoseconds : 0.0);
+    if(i==IndexTrace::INSERT || i==IndexTrace::REMOVE) {
+      cout<<endl;
+      continue;
+    }
+    cout<<setw(14)<<total.results<<setw(12)<<total.mismatches<<endl;
+  }
+  cout<<"Total time [ms]: "<<fixed<<setprecision(1)<<allNanoseconds/1000000.0<<endl;
+  cout<<"Peak index memory [KB]: "<<(peakMemory-baseMemory)/1024<<endl;
+}
+
+int main(int argc, char* argv[])
+{
+  CALL("main");
+
+  Timer::ensureTimerInitialized();
+
+  bool overrideTerm=false;
+  IndexTrace::Structure termStructure=IndexTrace::SUBSTITUTION_TREE;
+  if(argc==4 && !strcmp(argv[2], "-t") && (!strcmp(argv[3], "subst") || !strcmp(argv[3], "code"))) {
+    overrideTerm=true;
+    termStructure=strcmp(argv[3], "code") ? IndexTrace::SUBSTITUTION_TREE : IndexTrace::CODE_TREE;
+  }
+  else if(argc!=2) {
+    cout<<"Usage: vindexreplay <trace file> [-t subst|code]"<<endl;
+    return 1;
+  }
+
+  Lib::Random::resetSeed();
+  Allocator::setMemoryLimit(1000000000); //memory limit set to 1g
+
+  env.options->setTimeLimitInDeciseconds(0);
+
+  try {
+    replay(argv[1], overrideTerm, termStructure);
+  }
+  catch(UserErrorException& exception) {
+    exception.cry(cout);
+    return 1;
+  }
+  return 0;
+}